@@ -29,8 +29,18 @@ public:
 	unsigned int regenerateDMR(unsigned char* bytes) const;
 	unsigned int regenerateDStar(unsigned char* bytes) const;
 
+	// Regenerate count consecutive DMR bursts of 33 bytes, or D-Star voice
+	// frames of 9 bytes, returning the total number of bits corrected
+	unsigned int regenerateDMR(unsigned char* bytes, unsigned int count) const;
+	unsigned int regenerateDStar(unsigned char* bytes, unsigned int count) const;
+
 private:
-	unsigned int regenerate(unsigned int& a, unsigned int& b, unsigned int& c) const;
+	unsigned int regenerate(unsigned int* a, unsigned int* b, unsigned int n, bool dmr) const;
+
+	unsigned int gather(const unsigned char* bytes, const unsigned int* table, unsigned int length) const;
+	void scatter(unsigned char* bytes, const unsigned int* table, unsigned int length, unsigned int diff) const;
+
+	unsigned int countBits(unsigned int v) const;
 };
 
 #endif
@@ -20,24 +20,45 @@
 #include "BPTC19696.h"
 
 #include "Hamming.h"
-#include "Utils.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
-CBPTC19696::CBPTC19696() :
-m_rawData(NULL),
-m_deInterData(NULL)
+const unsigned int BPTC_ROWS      = 13U;
+const unsigned int BPTC_COLUMNS   = 15U;
+const unsigned int BPTC_DATA_ROWS = 9U;
+
+const unsigned int RAW_LENGTH_BYTES = 25U;
+
+// The position in the raw data of each de-interleaved bit, (a * 181) % 196
+const unsigned char INTERLEAVE_TABLE[] =
+	{0U, 181U, 166U, 151U, 136U, 121U, 106U, 91U, 76U, 61U, 46U, 31U, 16U, 1U,
+	 182U, 167U, 152U, 137U, 122U, 107U, 92U, 77U, 62U, 47U, 32U, 17U, 2U, 183U,
+	 168U, 153U, 138U, 123U, 108U, 93U, 78U, 63U, 48U, 33U, 18U, 3U, 184U, 169U,
+	 154U, 139U, 124U, 109U, 94U, 79U, 64U, 49U, 34U, 19U, 4U, 185U, 170U, 155U,
+	 140U, 125U, 110U, 95U, 80U, 65U, 50U, 35U, 20U, 5U, 186U, 171U, 156U, 141U,
+	 126U, 111U, 96U, 81U, 66U, 51U, 36U, 21U, 6U, 187U, 172U, 157U, 142U, 127U,
+	 112U, 97U, 82U, 67U, 52U, 37U, 22U, 7U, 188U, 173U, 158U, 143U, 128U, 113U,
+	 98U, 83U, 68U, 53U, 38U, 23U, 8U, 189U, 174U, 159U, 144U, 129U, 114U, 99U,
+	 84U, 69U, 54U, 39U, 24U, 9U, 190U, 175U, 160U, 145U, 130U, 115U, 100U, 85U,
+	 70U, 55U, 40U, 25U, 10U, 191U, 176U, 161U, 146U, 131U, 116U, 101U, 86U, 71U,
+	 56U, 41U, 26U, 11U, 192U, 177U, 162U, 147U, 132U, 117U, 102U, 87U, 72U, 57U,
+	 42U, 27U, 12U, 193U, 178U, 163U, 148U, 133U, 118U, 103U, 88U, 73U, 58U, 43U,
+	 28U, 13U, 194U, 179U, 164U, 149U, 134U, 119U, 104U, 89U, 74U, 59U, 44U, 29U,
+	 14U, 195U, 180U, 165U, 150U, 135U, 120U, 105U, 90U, 75U, 60U, 45U, 30U, 15U};
+
+// The row to flip in a column for each Hamming (13,9,3) syndrome, 0xFF if the
+// syndrome doesn't match a single bit error
+const unsigned char CORRECTION_TABLE_1393[] =
+	{0xFFU, 0x09U, 0x0AU, 0x06U, 0x0BU, 0x03U, 0x07U, 0x01U, 0x0CU, 0xFFU, 0x04U, 0xFFU, 0x08U, 0x05U, 0x02U, 0x00U};
+
+CBPTC19696::CBPTC19696()
 {
-	m_rawData     = new bool[196];
-	m_deInterData = new bool[196];
 }
 
 CBPTC19696::~CBPTC19696()
 {
-	delete[] m_rawData;
-	delete[] m_deInterData;
 }
 
 // The main decode function
@@ -46,17 +67,20 @@ void CBPTC19696::decode(const unsigned char* in, unsigned char* out)
 	assert(in != NULL);
 	assert(out != NULL);
 
+	unsigned char raw[RAW_LENGTH_BYTES];
+	unsigned short rows[BPTC_ROWS];
+
 	//  Get the raw binary
-	decodeExtractBinary(in);
+	decodeExtractBinary(in, raw);
 
 	// Deinterleave
-	decodeDeInterleave();
+	decodeDeInterleave(raw, rows);
 
 	// Error check
-	decodeErrorCheck();
+	decodeErrorCheck(rows);
 
 	// Extract Data
-	decodeExtractData(out);
+	decodeExtractData(rows, out);
 }
 
 // The main encode function
@@ -65,282 +89,182 @@ void CBPTC19696::encode(const unsigned char* in, unsigned char* out)
 	assert(in != NULL);
 	assert(out != NULL);
 
+	unsigned char raw[RAW_LENGTH_BYTES];
+	unsigned short rows[BPTC_ROWS];
+
 	// Extract Data
-	encodeExtractData(in);
+	encodeExtractData(in, rows);
 
 	// Error check
-	encodeErrorCheck();
+	encodeErrorCheck(rows);
 
 	// Deinterleave
-	encodeInterleave();
+	encodeInterleave(rows, raw);
 
 	//  Get the raw binary
-	encodeExtractBinary(out);
+	encodeExtractBinary(raw, out);
 }
 
-void CBPTC19696::decodeExtractBinary(const unsigned char* in)
+// Pack the two 98 bit halves either side of the slot type and sync together
+void CBPTC19696::decodeExtractBinary(const unsigned char* in, unsigned char* raw) const
 {
 	// First block
-	CUtils::byteToBitsBE(in[0U],  m_rawData + 0U);
-	CUtils::byteToBitsBE(in[1U],  m_rawData + 8U);
-	CUtils::byteToBitsBE(in[2U],  m_rawData + 16U);
-	CUtils::byteToBitsBE(in[3U],  m_rawData + 24U);
-	CUtils::byteToBitsBE(in[4U],  m_rawData + 32U);
-	CUtils::byteToBitsBE(in[5U],  m_rawData + 40U);
-	CUtils::byteToBitsBE(in[6U],  m_rawData + 48U);
-	CUtils::byteToBitsBE(in[7U],  m_rawData + 56U);
-	CUtils::byteToBitsBE(in[8U],  m_rawData + 64U);
-	CUtils::byteToBitsBE(in[9U],  m_rawData + 72U);
-	CUtils::byteToBitsBE(in[10U], m_rawData + 80U);
-	CUtils::byteToBitsBE(in[11U], m_rawData + 88U);
-	CUtils::byteToBitsBE(in[12U], m_rawData + 96U);
+	::memcpy(raw, in, 12U);
 
-	// Handle the two bits
-	bool bits[8U];
-	CUtils::byteToBitsBE(in[20U], bits);
-	m_rawData[98U] = bits[6U];
-	m_rawData[99U] = bits[7U];
+	// Handle the two bits at the end of each block
+	raw[12U] = (in[12U] & 0xC0U) | ((in[20U] & 0x03U) << 4) | (in[21U] >> 4);
 
 	// Second block
-	CUtils::byteToBitsBE(in[21U], m_rawData + 100U);
-	CUtils::byteToBitsBE(in[22U], m_rawData + 108U);
-	CUtils::byteToBitsBE(in[23U], m_rawData + 116U);
-	CUtils::byteToBitsBE(in[24U], m_rawData + 124U);
-	CUtils::byteToBitsBE(in[25U], m_rawData + 132U);
-	CUtils::byteToBitsBE(in[26U], m_rawData + 140U);
-	CUtils::byteToBitsBE(in[27U], m_rawData + 148U);
-	CUtils::byteToBitsBE(in[28U], m_rawData + 156U);
-	CUtils::byteToBitsBE(in[29U], m_rawData + 164U);
-	CUtils::byteToBitsBE(in[30U], m_rawData + 172U);
-	CUtils::byteToBitsBE(in[31U], m_rawData + 180U);
-	CUtils::byteToBitsBE(in[32U], m_rawData + 188U);
+	for (unsigned int i = 13U; i < 24U; i++)
+		raw[i] = (in[i + 8U] << 4) | (in[i + 9U] >> 4);
+
+	raw[24U] = in[32U] << 4;
 }
 
-// Deinterleave the raw data
-void CBPTC19696::decodeDeInterleave()
+// Deinterleave the raw data into the rows
+void CBPTC19696::decodeDeInterleave(const unsigned char* raw, unsigned short* rows) const
 {
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
 	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Shuffle the data
-		m_deInterData[a] = m_rawData[interleaveSequence];
+	unsigned int a = 1U;
+	for (unsigned int r = 0U; r < BPTC_ROWS; r++) {
+		unsigned int row = 0U;
+		for (unsigned int c = 0U; c < BPTC_COLUMNS; c++, a++) {
+			unsigned int pos = INTERLEAVE_TABLE[a];
+			row = (row << 1) | ((raw[pos >> 3] >> (7U - (pos & 7U))) & 0x01U);
+		}
+
+		rows[r] = row;
 	}
 }
-	
+
 // Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
-void CBPTC19696::decodeErrorCheck()
+void CBPTC19696::decodeErrorCheck(unsigned short* rows) const
 {
 	bool fixing;
 	unsigned int count = 0U;
 	do {
 		fixing = false;
 
-		// Run through each of the 15 columns
-		bool col[13U];
-		for (unsigned int c = 0U; c < 15U; c++) {
-			unsigned int pos = c + 1U;
-			for (unsigned int a = 0U; a < 13U; a++) {
-				col[a] = m_deInterData[pos];
-				pos = pos + 15U;
-			}
-
-			if (CHamming::decode1393(col)) {
-				unsigned int pos = c + 1U;
-				for (unsigned int a = 0U; a < 13U; a++) {
-					m_deInterData[pos] = col[a];
-					pos = pos + 15U;
+		// The syndromes of all 15 columns at once, bit c of each word belongs to column c
+		unsigned int s0 = rows[0U] ^ rows[1U] ^ rows[3U] ^ rows[5U] ^ rows[6U] ^ rows[9U];
+		unsigned int s1 = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[4U] ^ rows[6U] ^ rows[7U] ^ rows[10U];
+		unsigned int s2 = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[5U] ^ rows[7U] ^ rows[8U] ^ rows[11U];
+		unsigned int s3 = rows[0U] ^ rows[2U] ^ rows[4U] ^ rows[5U] ^ rows[8U] ^ rows[12U];
+
+		if ((s0 | s1 | s2 | s3) != 0U) {
+			for (unsigned int bit = 0x4000U; bit > 0U; bit >>= 1) {
+				unsigned int n = 0x00U;
+				n |= (s0 & bit) ? 0x01U : 0x00U;
+				n |= (s1 & bit) ? 0x02U : 0x00U;
+				n |= (s2 & bit) ? 0x04U : 0x00U;
+				n |= (s3 & bit) ? 0x08U : 0x00U;
+
+				unsigned char r = CORRECTION_TABLE_1393[n];
+				if (r != 0xFFU) {
+					rows[r] ^= bit;
+					fixing = true;
 				}
-
-				fixing = true;
 			}
 		}
-		
+
 		// Run through each of the 9 rows containing data
-		for (unsigned int r = 0U; r < 9U; r++) {
-			unsigned int pos = (r * 15U) + 1U;
-			if (CHamming::decode15113(m_deInterData + pos))
+		for (unsigned int r = 0U; r < BPTC_DATA_ROWS; r++) {
+			unsigned int row = rows[r];
+			if (CHamming::decode15113(row)) {
+				rows[r] = row;
 				fixing = true;
+			}
 		}
 
 		count++;
 	} while (fixing && count < 5U);
 }
 
-// Extract the 96 bits of payload
-void CBPTC19696::decodeExtractData(unsigned char* data) const
+// Extract the 96 bits of payload, the first row only holds eight of them
+void CBPTC19696::decodeExtractData(const unsigned short* rows, unsigned char* data) const
 {
-	bool bData[96U];
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	CUtils::bitsToByteBE(bData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(bData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(bData + 16U, data[2U]);
-	CUtils::bitsToByteBE(bData + 24U, data[3U]);
-	CUtils::bitsToByteBE(bData + 32U, data[4U]);
-	CUtils::bitsToByteBE(bData + 40U, data[5U]);
-	CUtils::bitsToByteBE(bData + 48U, data[6U]);
-	CUtils::bitsToByteBE(bData + 56U, data[7U]);
-	CUtils::bitsToByteBE(bData + 64U, data[8U]);
-	CUtils::bitsToByteBE(bData + 72U, data[9U]);
-	CUtils::bitsToByteBE(bData + 80U, data[10U]);
-	CUtils::bitsToByteBE(bData + 88U, data[11U]);
-}
+	data[0U] = rows[0U] >> 4;
+
+	unsigned int n = 1U;
+	unsigned int bits = 0U;
+	unsigned int acc = 0U;
+	for (unsigned int r = 1U; r < BPTC_DATA_ROWS; r++) {
+		acc  = (acc << 11) | ((rows[r] >> 4) & 0x7FFU);
+		bits += 11U;
+
+		while (bits >= 8U) {
+			bits -= 8U;
+			data[n++] = acc >> bits;
+		}
 
-// Extract the 96 bits of payload
-void CBPTC19696::encodeExtractData(const unsigned char* in) const
-{
-	bool bData[96U];
-	CUtils::byteToBitsBE(in[0U],  bData + 0U);
-	CUtils::byteToBitsBE(in[1U],  bData + 8U);
-	CUtils::byteToBitsBE(in[2U],  bData + 16U);
-	CUtils::byteToBitsBE(in[3U],  bData + 24U);
-	CUtils::byteToBitsBE(in[4U],  bData + 32U);
-	CUtils::byteToBitsBE(in[5U],  bData + 40U);
-	CUtils::byteToBitsBE(in[6U],  bData + 48U);
-	CUtils::byteToBitsBE(in[7U],  bData + 56U);
-	CUtils::byteToBitsBE(in[8U],  bData + 64U);
-	CUtils::byteToBitsBE(in[9U],  bData + 72U);
-	CUtils::byteToBitsBE(in[10U], bData + 80U);
-	CUtils::byteToBitsBE(in[11U], bData + 88U);
-
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		m_deInterData[a] = bData[pos];
+		acc &= (1U << bits) - 1U;
+	}
 }
 
-// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
-void CBPTC19696::encodeErrorCheck()
+// Place the 96 bits of payload into the rows
+void CBPTC19696::encodeExtractData(const unsigned char* in, unsigned short* rows) const
 {
-	// Run through each of the 15 columns
-	bool col[13U];
-	for (unsigned int c = 0U; c < 15U; c++) {
-		unsigned int pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			col[a] = m_deInterData[pos];
-			pos = pos + 15U;
+	rows[0U] = in[0U] << 4;
+
+	unsigned int n = 1U;
+	unsigned int bits = 0U;
+	unsigned int acc = 0U;
+	for (unsigned int r = 1U; r < BPTC_DATA_ROWS; r++) {
+		while (bits < 11U) {
+			acc  = (acc << 8) | in[n++];
+			bits += 8U;
 		}
 
-		CHamming::encode1393(col);
+		bits -= 11U;
+		rows[r] = ((acc >> bits) & 0x7FFU) << 4;
 
-		pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			m_deInterData[pos] = col[a];
-			pos = pos + 15U;
-		}
+		acc &= (1U << bits) - 1U;
 	}
 
+	for (unsigned int r = BPTC_DATA_ROWS; r < BPTC_ROWS; r++)
+		rows[r] = 0U;
+}
+
+// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
+void CBPTC19696::encodeErrorCheck(unsigned short* rows) const
+{
+	// All 15 columns at once, before the row parity is added
+	rows[9U]  = rows[0U] ^ rows[1U] ^ rows[3U] ^ rows[5U] ^ rows[6U];
+	rows[10U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[4U] ^ rows[6U] ^ rows[7U];
+	rows[11U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[5U] ^ rows[7U] ^ rows[8U];
+	rows[12U] = rows[0U] ^ rows[2U] ^ rows[4U] ^ rows[5U] ^ rows[8U];
+
 	// Run through each of the 9 rows containing data
-	for (unsigned int r = 0U; r < 9U; r++) {
-		unsigned int pos = (r * 15U) + 1U;
-		CHamming::encode15113(m_deInterData + pos);
-	}
+	for (unsigned int r = 0U; r < BPTC_DATA_ROWS; r++)
+		rows[r] = CHamming::encode15113(rows[r]);
 }
 
-// Interleave the raw data
-void CBPTC19696::encodeInterleave()
+// Interleave the rows into the raw data
+void CBPTC19696::encodeInterleave(const unsigned short* rows, unsigned char* raw) const
 {
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_rawData[i] = false;
+	::memset(raw, 0x00U, RAW_LENGTH_BYTES);
 
 	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Unshuffle the data
-		m_rawData[interleaveSequence] = m_deInterData[a];
+	unsigned int a = 1U;
+	for (unsigned int r = 0U; r < BPTC_ROWS; r++) {
+		unsigned int row = rows[r];
+		for (unsigned int c = 0U; c < BPTC_COLUMNS; c++, a++) {
+			unsigned int pos = INTERLEAVE_TABLE[a];
+			raw[pos >> 3] |= ((row >> (14U - c)) & 0x01U) << (7U - (pos & 7U));
+		}
 	}
 }
 
-void CBPTC19696::encodeExtractBinary(unsigned char* data)
+void CBPTC19696::encodeExtractBinary(const unsigned char* raw, unsigned char* data) const
 {
 	// First block
-	CUtils::bitsToByteBE(m_rawData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_rawData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_rawData + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_rawData + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_rawData + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_rawData + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_rawData + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_rawData + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_rawData + 64U, data[8U]);
-	CUtils::bitsToByteBE(m_rawData + 72U, data[9U]);
-	CUtils::bitsToByteBE(m_rawData + 80U, data[10U]);
-	CUtils::bitsToByteBE(m_rawData + 88U, data[11U]);
+	::memcpy(data, raw, 12U);
 
 	// Handle the two bits
-	unsigned char byte;
-	CUtils::bitsToByteBE(m_rawData + 96U, byte);
-	data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-	data[13U] = (data[13U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-// Second block
-	CUtils::bitsToByteBE(m_rawData + 100U,  data[21U]);
-	CUtils::bitsToByteBE(m_rawData + 108U,  data[22U]);
-	CUtils::bitsToByteBE(m_rawData + 116U,  data[23U]);
-	CUtils::bitsToByteBE(m_rawData + 124U,  data[24U]);
-	CUtils::bitsToByteBE(m_rawData + 132U,  data[25U]);
-	CUtils::bitsToByteBE(m_rawData + 140U,  data[26U]);
-	CUtils::bitsToByteBE(m_rawData + 148U,  data[27U]);
-	CUtils::bitsToByteBE(m_rawData + 156U,  data[28U]);
-	CUtils::bitsToByteBE(m_rawData + 164U,  data[29U]);
-	CUtils::bitsToByteBE(m_rawData + 172U,  data[30U]);
-	CUtils::bitsToByteBE(m_rawData + 180U,  data[31U]);
-	CUtils::bitsToByteBE(m_rawData + 188U,  data[32U]);
+	data[12U] = (data[12U] & 0x3FU) | ((raw[12U] >> 0) & 0xC0U);
+	data[13U] = (data[13U] & 0xFCU) | ((raw[12U] >> 4) & 0x03U);
+
+	// Second block
+	for (unsigned int i = 0U; i < 12U; i++)
+		data[i + 21U] = (raw[i + 12U] << 4) | (raw[i + 13U] >> 4);
 }
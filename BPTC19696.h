@@ -19,6 +19,8 @@
 #if !defined(BPTC19696_H)
 #define	BPTC19696_H
 
+// The rows of the 13x15 BPTC matrix are held as 15 bit words, column 0 in
+// bit 14, so the row and column Hamming codes work on whole words.
 class CBPTC19696
 {
 public:
@@ -30,18 +32,15 @@ public:
 	void encode(const unsigned char* in, unsigned char* out);
 
 private:
-	bool* m_rawData;
-	bool* m_deInterData;
-
-	void decodeExtractBinary(const unsigned char* in);
-	void decodeErrorCheck();
-	void decodeDeInterleave();
-	void decodeExtractData(unsigned char* data) const;
-
-	void encodeExtractData(const unsigned char* in) const;
-	void encodeInterleave();
-	void encodeErrorCheck();
-	void encodeExtractBinary(unsigned char* data);
+	void decodeExtractBinary(const unsigned char* in, unsigned char* raw) const;
+	void decodeDeInterleave(const unsigned char* raw, unsigned short* rows) const;
+	void decodeErrorCheck(unsigned short* rows) const;
+	void decodeExtractData(const unsigned short* rows, unsigned char* data) const;
+
+	void encodeExtractData(const unsigned char* in, unsigned short* rows) const;
+	void encodeErrorCheck(unsigned short* rows) const;
+	void encodeInterleave(const unsigned short* rows, unsigned char* raw) const;
+	void encodeExtractBinary(const unsigned char* raw, unsigned char* data) const;
 };
 
 #endif
@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Runs a corpus of random payloads through the BPTC (196,96) encoder, adds up
+// to five bit errors anywhere in each burst and decodes it again. The hashes
+// of the bursts and of the decoded payloads are compared with those recorded
+// from the bool array implementation. The encoder leaves the bits that it
+// doesn't own alone, so each burst starts out as random bytes.
+
+#include "BPTC19696.h"
+#include "FNV.h"
+
+#include <cstdio>
+
+const unsigned int CORPUS_FRAMES = 300000U;
+
+const unsigned int ENCODE_CHECKSUM = 0x303892CFU;
+const unsigned int DECODE_CHECKSUM = 0x06EC0377U;
+
+static unsigned int m_random = 0x12345678U;
+
+// xorshift32, the same corpus every run
+static unsigned int nextRandom()
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+
+	return m_random;
+}
+
+static bool check(const char* name, unsigned int checksum, unsigned int expected)
+{
+	if (checksum != expected) {
+		::fprintf(stdout, "%-8s FAILED, checksum 0x%08X, expected 0x%08X\n", name, checksum, expected);
+		return false;
+	}
+
+	::fprintf(stdout, "%-8s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	CBPTC19696 bptc;
+
+	CFNV encodeHash;
+	CFNV decodeHash;
+
+	for (unsigned int n = 0U; n < CORPUS_FRAMES; n++) {
+		unsigned char payload[12U];
+		for (unsigned int i = 0U; i < 12U; i++)
+			payload[i] = nextRandom();
+
+		unsigned char burst[33U];
+		for (unsigned int i = 0U; i < 33U; i++)
+			burst[i] = nextRandom();
+
+		bptc.encode(payload, burst);
+		encodeHash.add(burst, 33U);
+
+		unsigned int errors = nextRandom() % 6U;
+		for (unsigned int i = 0U; i < errors; i++) {
+			unsigned int pos = nextRandom() % 264U;
+			burst[pos / 8U] ^= 0x80U >> (pos % 8U);
+		}
+
+		bptc.decode(burst, payload);
+		decodeHash.add(payload, 12U);
+	}
+
+	unsigned int failed = 0U;
+
+	if (!check("encode", encodeHash.get(), ENCODE_CHECKSUM))
+		failed++;
+	if (!check("decode", decodeHash.get(), DECODE_CHECKSUM))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u BPTC (196,96) routines differ from the bool array implementation\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
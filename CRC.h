@@ -22,14 +22,18 @@
 class CCRC
 {
 public:
-	static bool checkFiveBit(bool* in, unsigned int tcrc);
-	static void encodeFiveBit(const bool* in, unsigned int& tcrc);
+	static bool checkFiveBit(const unsigned char* in, unsigned int tcrc);
+	static void encodeFiveBit(const unsigned char* in, unsigned int& tcrc);
 
 	static bool checkCSBK(const unsigned char* in);
 
 	static unsigned char encodeEightBit(const unsigned char* in, unsigned int length);
 
 	static unsigned char crc8(const unsigned char* in, unsigned int length);
+
+	static unsigned short crc16(const unsigned char* in, unsigned int length);
+
+	static unsigned int crc32(const unsigned char* in, unsigned int length);
 };
 
 #endif
@@ -0,0 +1,248 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Checks the table driven CRCs in CCRC against the catalogue check values and
+// against bitwise references on random buffers. The references for CRC-8 and
+// the CSBK check are the bitwise routines that the tables replaced.
+
+#include "CRC.h"
+
+#include <cstdio>
+#include <cstring>
+
+const unsigned int RANDOM_BUFFERS = 2000000U;
+const unsigned int MAX_BUFFER_LENGTH = 39U;
+
+const unsigned char CHECK_DATA[] = "123456789";
+
+const unsigned char  CRC8_CHECK  = 0xF4U;
+const unsigned short CRC16_CHECK = 0x31C3U;
+// The CRC-32/POSIX check value is 765E7680, after a final inversion that this CRC doesn't do
+const unsigned int   CRC32_CHECK = 0x89A1897FU;
+
+static unsigned int m_random = 0x12345678U;
+
+// xorshift32, the same buffers every run
+static unsigned int nextRandom()
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+
+	return m_random;
+}
+
+// The previous CCRC::crc8()
+static unsigned char refCRC8(const unsigned char* in, unsigned int length)
+{
+	unsigned int crc = 0U;
+
+	for (unsigned int j = 0U; j < length; j++, in++) {
+		crc ^= (*in << 8);
+
+		for (unsigned int i = 0U; i < 8U; i++) {
+			if (crc & 0x8000U)
+				crc ^= (0x1070U << 3);
+			crc <<= 1;
+		}
+	}
+
+	return crc >> 8;
+}
+
+// The previous CCRC::encodeEightBit()
+static unsigned char refEncodeEightBit(const unsigned char* in, unsigned int length)
+{
+	unsigned char crc = 0x00U;
+
+	for (unsigned int i = 0U; i < length; i++) {
+		crc ^= in[i];
+
+		for (unsigned int j = 0U; j < 8U; j++) {
+			if ((crc & 0x80U) == 0x80U) {
+				crc <<= 1;
+				crc ^= 0x07U;
+			} else {
+				crc <<= 1;
+			}
+		}
+	}
+
+	return crc;
+}
+
+// The CRC-CCITT loop of the previous CCRC::checkCSBK()
+static unsigned short refCRC16(const unsigned char* in, unsigned int length)
+{
+	unsigned short crc16 = 0U;
+
+	for (unsigned int a = 0U; a < length; a++) {
+		unsigned char val = in[a];
+
+		for (unsigned int i = 0U; i < 8U; i++) {
+			bool c15 = (crc16 >> 15 & 0x01U) == 0x01U;
+			bool bit = (val >> (7 - i) & 0x01U) == 0x01U;
+			crc16 <<= 1;
+			if (c15 ^ bit)
+				crc16 ^= 0x1021U;
+		}
+	}
+
+	return crc16;
+}
+
+// The previous CCRC::checkCSBK()
+static bool refCheckCSBK(const unsigned char* in)
+{
+	unsigned short crc16 = 0U;
+
+	for (unsigned int a = 0; a < 12U; a++)	{
+		unsigned char val = in[a];
+
+		if (a > 9U)
+			val ^= 0xA5U;
+
+		for (unsigned int i = 0U; i < 8U; i++) {
+			bool c15 = (crc16 >> 15 & 0x01U) == 0x01U;
+			bool bit = (val >> (7 - i) & 0x01U) == 0x01U;
+			crc16 <<= 1;
+			if (c15 ^ bit)
+				crc16 ^= 0x1021U;
+		}
+	}
+
+	return crc16 == 0x1D0FU;
+}
+
+static unsigned int refCRC32(const unsigned char* in, unsigned int length)
+{
+	unsigned int crc = 0x00000000U;
+
+	for (unsigned int i = 0U; i < length; i++) {
+		crc ^= in[i] << 24;
+
+		for (unsigned int j = 0U; j < 8U; j++) {
+			if ((crc & 0x80000000U) == 0x80000000U)
+				crc = (crc << 1) ^ 0x04C11DB7U;
+			else
+				crc <<= 1;
+		}
+	}
+
+	return crc;
+}
+
+// The two bytes whose CRC is the residue of a valid CSBK, as the CRC is linear
+// appending them XORed with the CRC of the first ten bytes gives a valid CSBK
+static unsigned short getCSBKResidueBytes()
+{
+	for (unsigned int value = 0U; value < 0x10000U; value++) {
+		unsigned char bytes[2U];
+		bytes[0U] = value >> 8;
+		bytes[1U] = value;
+
+		if (refCRC16(bytes, 2U) == 0x1D0FU)
+			return value;
+	}
+
+	return 0U;
+}
+
+static bool check(const char* name, unsigned int mismatches, unsigned int value, unsigned int expected)
+{
+	if (mismatches > 0U || value != expected) {
+		::fprintf(stdout, "%-16s FAILED, %u mismatches, check value 0x%X, expected 0x%X\n", name, mismatches, value, expected);
+		return false;
+	}
+
+	::fprintf(stdout, "%-16s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int crc8Mismatches = 0U;
+	unsigned int eightBitMismatches = 0U;
+	unsigned int crc16Mismatches = 0U;
+	unsigned int csbkMismatches = 0U;
+	unsigned int crc32Mismatches = 0U;
+
+	unsigned int badCSBKs = 0U;
+
+	unsigned short residue = getCSBKResidueBytes();
+
+	for (unsigned int n = 0U; n < RANDOM_BUFFERS; n++) {
+		unsigned char buffer[MAX_BUFFER_LENGTH];
+
+		unsigned int length = nextRandom() % (MAX_BUFFER_LENGTH + 1U);
+		for (unsigned int i = 0U; i < length; i++)
+			buffer[i] = nextRandom();
+
+		if (CCRC::crc8(buffer, length) != refCRC8(buffer, length))
+			crc8Mismatches++;
+		if (CCRC::encodeEightBit(buffer, length) != refEncodeEightBit(buffer, length))
+			eightBitMismatches++;
+		if (CCRC::crc16(buffer, length) != refCRC16(buffer, length))
+			crc16Mismatches++;
+		if (CCRC::crc32(buffer, length) != refCRC32(buffer, length))
+			crc32Mismatches++;
+
+		// A CSBK from the first twelve bytes, half of them with a valid masked CRC
+		unsigned char csbk[12U];
+		for (unsigned int i = 0U; i < 12U; i++)
+			csbk[i] = nextRandom();
+
+		bool fixed = (nextRandom() & 0x01U) == 0x01U;
+		if (fixed) {
+			unsigned short crc = refCRC16(csbk, 10U) ^ residue;
+			csbk[10U] = (crc >> 8) ^ 0xA5U;
+			csbk[11U] = (crc & 0xFFU) ^ 0xA5U;
+		}
+
+		bool valid = refCheckCSBK(csbk);
+		if (CCRC::checkCSBK(csbk) != valid)
+			csbkMismatches++;
+		if (fixed && !valid)
+			badCSBKs++;
+	}
+
+	unsigned int length = ::strlen((const char*)CHECK_DATA);
+
+	unsigned int failed = 0U;
+
+	if (!check("crc8", crc8Mismatches, CCRC::crc8(CHECK_DATA, length), CRC8_CHECK))
+		failed++;
+	if (!check("encodeEightBit", eightBitMismatches, CCRC::encodeEightBit(CHECK_DATA, length), CRC8_CHECK))
+		failed++;
+	if (!check("crc16", crc16Mismatches, CCRC::crc16(CHECK_DATA, length), CRC16_CHECK))
+		failed++;
+	if (!check("crc32", crc32Mismatches, CCRC::crc32(CHECK_DATA, length), CRC32_CHECK))
+		failed++;
+
+	// The check value is the number of CSBKs given a valid CRC that the reference rejected
+	if (!check("checkCSBK", csbkMismatches, badCSBKs, 0U))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u CRCs differ from the bitwise CRCs\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Reads a capture file written by MMDVMHost and prints the frames as text, or
+// converts them to pcapng for Wireshark. The modem frames appear on an
+// interface with the USER0 link type and the Homebrew packets on one with the
+// USER1 link type.
+
+#include "FrameCapture.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+const unsigned int PCAPNG_SECTION_HEADER   = 0x0A0D0D0AU;
+const unsigned int PCAPNG_INTERFACE        = 0x00000001U;
+const unsigned int PCAPNG_ENHANCED_PACKET  = 0x00000006U;
+const unsigned int PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4DU;
+
+const unsigned int LINKTYPE_USER0 = 147U;
+const unsigned int LINKTYPE_USER1 = 148U;
+
+const unsigned int OPT_ENDOFOPT  = 0U;
+const unsigned int OPT_IF_NAME   = 2U;
+const unsigned int OPT_EPB_FLAGS = 2U;
+
+const unsigned int EPB_FLAGS_INBOUND  = 1U;
+const unsigned int EPB_FLAGS_OUTBOUND = 2U;
+
+const char* SOURCES[]    = {"Modem", "Network"};
+const char* DIRECTIONS[] = {"RX", "TX"};
+
+static unsigned long long getLE(const unsigned char* p, unsigned int length)
+{
+	unsigned long long value = 0U;
+	for (unsigned int i = length; i > 0U; i--)
+		value = (value << 8) | p[i - 1U];
+
+	return value;
+}
+
+static unsigned int setLE(unsigned char* p, unsigned long long value, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++, value >>= 8)
+		p[i] = (unsigned char)value;
+
+	return length;
+}
+
+static unsigned int pad(unsigned int length)
+{
+	return (length + 3U) & ~3U;
+}
+
+// Adds an option to a block, padded to four bytes
+static unsigned int setOption(unsigned char* p, unsigned int code, const unsigned char* data, unsigned int length)
+{
+	setLE(p + 0U, code, 2U);
+	setLE(p + 2U, length, 2U);
+
+	::memset(p + 4U, 0x00U, pad(length));
+	if (length > 0U)
+		::memcpy(p + 4U, data, length);
+
+	return 4U + pad(length);
+}
+
+static void writeSectionHeader(FILE* fp)
+{
+	unsigned char block[28U];
+	unsigned int n = 0U;
+
+	n += setLE(block + n, PCAPNG_SECTION_HEADER, 4U);
+	n += setLE(block + n, 28U, 4U);
+	n += setLE(block + n, PCAPNG_BYTE_ORDER_MAGIC, 4U);
+	n += setLE(block + n, 1U, 2U);
+	n += setLE(block + n, 0U, 2U);
+	n += setLE(block + n, 0xFFFFFFFFFFFFFFFFULL, 8U);		// Section length not given
+	n += setLE(block + n, 28U, 4U);
+
+	::fwrite(block, 1U, n, fp);
+}
+
+static void writeInterface(FILE* fp, unsigned int linkType, const char* name)
+{
+	unsigned char block[100U];
+	unsigned int n = 8U;
+
+	n += setLE(block + n, linkType, 2U);
+	n += setLE(block + n, 0U, 2U);
+	n += setLE(block + n, 0U, 4U);		// No snap length
+	n += setOption(block + n, OPT_IF_NAME, (const unsigned char*)name, ::strlen(name));
+	n += setOption(block + n, OPT_ENDOFOPT, NULL, 0U);
+	n += 4U;
+
+	setLE(block + 0U, PCAPNG_INTERFACE, 4U);
+	setLE(block + 4U, n, 4U);
+	setLE(block + n - 4U, n, 4U);
+
+	::fwrite(block, 1U, n, fp);
+}
+
+static void writePacket(FILE* fp, unsigned int interfaceId, unsigned long long time, unsigned int direction, const unsigned char* data, unsigned int length)
+{
+	unsigned char block[CAPTURE_MAX_DATA_LENGTH + 100U];
+	unsigned int n = 8U;
+
+	n += setLE(block + n, interfaceId, 4U);
+	n += setLE(block + n, time >> 32, 4U);		// Microseconds since 1970, the default resolution
+	n += setLE(block + n, time, 4U);
+	n += setLE(block + n, length, 4U);
+	n += setLE(block + n, length, 4U);
+
+	::memset(block + n, 0x00U, pad(length));
+	::memcpy(block + n, data, length);
+	n += pad(length);
+
+	unsigned char flags[4U];
+	setLE(flags, direction == CD_RX ? EPB_FLAGS_INBOUND : EPB_FLAGS_OUTBOUND, 4U);
+	n += setOption(block + n, OPT_EPB_FLAGS, flags, 4U);
+	n += setOption(block + n, OPT_ENDOFOPT, NULL, 0U);
+	n += 4U;
+
+	setLE(block + 0U, PCAPNG_ENHANCED_PACKET, 4U);
+	setLE(block + 4U, n, 4U);
+	setLE(block + n - 4U, n, 4U);
+
+	::fwrite(block, 1U, n, fp);
+}
+
+static void printRecord(unsigned long long time, unsigned int source, unsigned int direction, unsigned int slot, unsigned int type, const unsigned char* data, unsigned int length)
+{
+	time_t t = time_t(time / 1000000ULL);
+	struct tm* tm = ::gmtime(&t);
+
+	::printf("%04d-%02d-%02d %02d:%02d:%02d.%06u %-7s %s", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, (unsigned int)(time % 1000000ULL),
+		SOURCES[source], DIRECTIONS[direction]);
+
+	if (slot > 0U)
+		::printf(" Slot %u", slot);
+	else
+		::printf("       ");
+
+	::printf(" Type %02X Length %3u:", type, length);
+
+	for (unsigned int i = 0U; i < length; i++)
+		::printf(" %02X", data[i]);
+
+	::printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 2 && argc != 3) {
+		::fprintf(stderr, "Usage: CaptureReader <capture file> [<pcapng file>]\n");
+		return 1;
+	}
+
+	FILE* in = ::fopen(argv[1], "rb");
+	if (in == NULL) {
+		::fprintf(stderr, "CaptureReader: cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	unsigned char header[CAPTURE_FILE_HEADER_LENGTH];
+	if (::fread(header, 1U, CAPTURE_FILE_HEADER_LENGTH, in) != CAPTURE_FILE_HEADER_LENGTH || ::memcmp(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH) != 0) {
+		::fprintf(stderr, "CaptureReader: %s is not a capture file\n", argv[1]);
+		::fclose(in);
+		return 1;
+	}
+
+	unsigned int version = (unsigned int)getLE(header + 8U, 4U);
+	if (version != CAPTURE_VERSION) {
+		::fprintf(stderr, "CaptureReader: %s is version %u, only version %u is understood\n", argv[1], version, CAPTURE_VERSION);
+		::fclose(in);
+		return 1;
+	}
+
+	unsigned int count = (unsigned int)getLE(header + 12U, 4U);
+
+	// The capture clock is converted to the wall clock using the pair of times from when it was written
+	unsigned long long wallClock = getLE(header + 16U, 8U);
+	unsigned long long now       = getLE(header + 24U, 8U);
+
+	FILE* out = NULL;
+	if (argc == 3) {
+		out = ::fopen(argv[2], "wb");
+		if (out == NULL) {
+			::fprintf(stderr, "CaptureReader: cannot open %s\n", argv[2]);
+			::fclose(in);
+			return 1;
+		}
+
+		writeSectionHeader(out);
+		writeInterface(out, LINKTYPE_USER0, "modem");
+		writeInterface(out, LINKTYPE_USER1, "homebrew");
+	}
+
+	unsigned int n;
+	for (n = 0U; n < count; n++) {
+		unsigned char record[CAPTURE_RECORD_HEADER_LENGTH];
+		if (::fread(record, 1U, CAPTURE_RECORD_HEADER_LENGTH, in) != CAPTURE_RECORD_HEADER_LENGTH)
+			break;
+
+		unsigned long long time = wallClock - (now - getLE(record + 0U, 8U));
+		unsigned int length     = (unsigned int)getLE(record + 8U, 2U);
+		unsigned int source     = record[10U];
+		unsigned int direction  = record[11U];
+		unsigned int slot       = record[12U];
+		unsigned int type       = record[13U];
+
+		if (length > CAPTURE_MAX_DATA_LENGTH || source > CS_NETWORK || direction > CD_TX)
+			break;
+
+		unsigned char data[CAPTURE_MAX_DATA_LENGTH];
+		if (::fread(data, 1U, length, in) != length)
+			break;
+
+		if (out != NULL)
+			writePacket(out, source, time, direction, data, length);
+		else
+			printRecord(time, source, direction, slot, type, data, length);
+	}
+
+	::fclose(in);
+
+	if (out != NULL)
+		::fclose(out);
+
+	if (n < count) {
+		::fprintf(stderr, "CaptureReader: %s is truncated or corrupt after %u of %u frames\n", argv[1], n, count);
+		return 1;
+	}
+
+	if (out != NULL)
+		::fprintf(stderr, "CaptureReader: wrote %u frames to %s\n", count, argv[2]);
+
+	return 0;
+}
@@ -25,14 +25,18 @@
 
 const int BUFFER_SIZE = 500;
 
+const unsigned int MAX_CAPTURE_MINUTES = 60U;
+
 enum SECTION {
   SECTION_NONE,
   SECTION_GENERAL,
   SECTION_INFO,
   SECTION_LOG,
+  SECTION_CAPTURE,
   SECTION_MODEM,
   SECTION_DSTAR,
   SECTION_DMR,
+  SECTION_DMR_RECORDER,
   SECTION_FUSION,
   SECTION_DSTAR_NETWORK,
   SECTION_DMR_NETWORK,
@@ -60,6 +64,8 @@ m_logLevel(0U),
 m_logPath(),
 m_logRoot(),
 m_logDisplay(true),
+m_captureEnabled(false),
+m_captureMinutes(5U),
 m_modemPort(),
 m_modemRXInvert(false),
 m_modemTXInvert(false),
@@ -68,12 +74,19 @@ m_modemTXDelay(100U),
 m_modemRXLevel(100U),
 m_modemTXLevel(100U),
 m_modemDebug(false),
+m_modemFramesPerTick(10U),
 m_dstarEnabled(true),
 m_dstarModule("C"),
 m_dmrEnabled(true),
 m_dmrBeacons(false),
 m_dmrId(0U),
 m_dmrColorCode(2U),
+m_dmrDebug(false),
+m_dmrRecorderEnabled(false),
+m_dmrRecorderPath(),
+m_dmrRecorderSlot1(true),
+m_dmrRecorderSlot2(true),
+m_dmrRecorderTalkGroups(),
 m_fusionEnabled(true),
 m_dstarNetworkEnabled(true),
 m_dstarGatewayAddress(),
@@ -119,12 +132,16 @@ bool CConf::read()
 		  section = SECTION_INFO;
 	  else if (::strncmp(buffer, "[Log]", 5U) == 0)
 		  section = SECTION_LOG;
+	  else if (::strncmp(buffer, "[Capture]", 9U) == 0)
+		  section = SECTION_CAPTURE;
 	  else if (::strncmp(buffer, "[Modem]", 7U) == 0)
         section = SECTION_MODEM;
 	  else if (::strncmp(buffer, "[D-Star]", 8U) == 0)
 		  section = SECTION_DSTAR;
 	  else if (::strncmp(buffer, "[DMR]", 5U) == 0)
 		  section = SECTION_DMR;
+	  else if (::strncmp(buffer, "[DMR Recorder]", 14U) == 0)
+		  section = SECTION_DMR_RECORDER;
 	  else if (::strncmp(buffer, "[System Fusion]", 15U) == 0)
 		  section = SECTION_FUSION;
 	  else if (::strncmp(buffer, "[D-Star Network]", 16U) == 0)
@@ -185,6 +202,17 @@ bool CConf::read()
 			m_logLevel = (unsigned int)::atoi(value);
 		else if (::strcmp(key, "Display") == 0)
 			m_logDisplay = ::atoi(value) == 1;
+	} else if (section == SECTION_CAPTURE) {
+		if (::strcmp(key, "Enable") == 0)
+			m_captureEnabled = ::atoi(value) == 1;
+		else if (::strcmp(key, "Minutes") == 0) {
+			// The ring is held in memory, half a megabyte a minute
+			m_captureMinutes = (unsigned int)::atoi(value);
+			if (m_captureMinutes > MAX_CAPTURE_MINUTES) {
+				::fprintf(stderr, "Warning: Minutes=%s in [Capture] is too large, using %u\n", value, MAX_CAPTURE_MINUTES);
+				m_captureMinutes = MAX_CAPTURE_MINUTES;
+			}
+		}
 	} else if (section == SECTION_MODEM) {
 		if (::strcmp(key, "Port") == 0)
 			m_modemPort = value;
@@ -202,6 +230,15 @@ bool CConf::read()
 			m_modemTXLevel = (unsigned int)::atoi(value);
 		else if (::strcmp(key, "Debug") == 0)
 			m_modemDebug = ::atoi(value) == 1;
+		else if (::strcmp(key, "FramesPerTick") == 0) {
+			// The log isn't open yet, and without at least one frame per tick the modem is never read
+			int frames = (value != NULL) ? ::atoi(value) : 0;
+			if (frames < 1) {
+				::fprintf(stderr, "Warning: FramesPerTick=%s is invalid, using 1\n", value != NULL ? value : "");
+				frames = 1;
+			}
+			m_modemFramesPerTick = (unsigned int)frames;
+		}
 	} else if (section == SECTION_DSTAR) {
 		if (::strcmp(key, "Enable") == 0)
 			m_dstarEnabled = ::atoi(value) == 1;
@@ -216,6 +253,25 @@ bool CConf::read()
 			m_dmrId = (unsigned int)::atoi(value);
 		else if (::strcmp(key, "ColorCode") == 0)
 			m_dmrColorCode = (unsigned int)::atoi(value);
+		else if (::strcmp(key, "Debug") == 0)
+			m_dmrDebug = ::atoi(value) == 1;
+	} else if (section == SECTION_DMR_RECORDER) {
+		if (::strcmp(key, "Enable") == 0)
+			m_dmrRecorderEnabled = ::atoi(value) == 1;
+		else if (::strcmp(key, "Path") == 0)
+			m_dmrRecorderPath = value;
+		else if (::strcmp(key, "Slot1") == 0)
+			m_dmrRecorderSlot1 = ::atoi(value) == 1;
+		else if (::strcmp(key, "Slot2") == 0)
+			m_dmrRecorderSlot2 = ::atoi(value) == 1;
+		else if (::strcmp(key, "TalkGroups") == 0 && value != NULL) {
+			// A comma separated list, empty for all of them
+			char* p = ::strtok(value, ", \t");
+			while (p != NULL) {
+				m_dmrRecorderTalkGroups.push_back((unsigned int)::atoi(p));
+				p = ::strtok(NULL, ", \t");
+			}
+		}
 	} else if (section == SECTION_FUSION) {
 		if (::strcmp(key, "Enable") == 0)
 			m_fusionEnabled = ::atoi(value) == 1;
@@ -351,6 +407,16 @@ bool CConf::getLogDisplay() const
   return m_logDisplay;
 }
 
+bool CConf::getCaptureEnabled() const
+{
+	return m_captureEnabled;
+}
+
+unsigned int CConf::getCaptureMinutes() const
+{
+	return m_captureMinutes;
+}
+
 std::string CConf::getModemPort() const
 {
 	return m_modemPort;
@@ -391,6 +457,11 @@ bool CConf::getModemDebug() const
 	return m_modemDebug;
 }
 
+unsigned int CConf::getModemFramesPerTick() const
+{
+	return m_modemFramesPerTick;
+}
+
 bool CConf::getDStarEnabled() const
 {
 	return m_dstarEnabled;
@@ -421,6 +492,36 @@ unsigned int CConf::getDMRColorCode() const
 	return m_dmrColorCode;
 }
 
+bool CConf::getDMRDebug() const
+{
+	return m_dmrDebug;
+}
+
+bool CConf::getDMRRecorderEnabled() const
+{
+	return m_dmrRecorderEnabled;
+}
+
+std::string CConf::getDMRRecorderPath() const
+{
+	return m_dmrRecorderPath;
+}
+
+bool CConf::getDMRRecorderSlot1() const
+{
+	return m_dmrRecorderSlot1;
+}
+
+bool CConf::getDMRRecorderSlot2() const
+{
+	return m_dmrRecorderSlot2;
+}
+
+std::vector<unsigned int> CConf::getDMRRecorderTalkGroups() const
+{
+	return m_dmrRecorderTalkGroups;
+}
+
 bool CConf::getFusionEnabled() const
 {
 	return m_fusionEnabled;
@@ -20,6 +20,7 @@
 #define	CONF_H
 
 #include <string>
+#include <vector>
 
 class CConf
 {
@@ -53,6 +54,10 @@ public:
   unsigned int getLogLevel() const;
   bool         getLogDisplay() const;
 
+  // The Capture section
+  bool         getCaptureEnabled() const;
+  unsigned int getCaptureMinutes() const;
+
   // The Modem section
   std::string  getModemPort() const;
   bool         getModemRXInvert() const;
@@ -62,6 +67,7 @@ public:
   unsigned int getModemRXLevel() const;
   unsigned int getModemTXLevel() const;
   bool         getModemDebug() const;
+  unsigned int getModemFramesPerTick() const;
 
   // The D-Star section
   bool         getDStarEnabled() const;
@@ -72,6 +78,14 @@ public:
   bool         getDMRBeacons() const;
   unsigned int getDMRId() const;
   unsigned int getDMRColorCode() const;
+  bool         getDMRDebug() const;
+
+  // The DMR Recorder section
+  bool         getDMRRecorderEnabled() const;
+  std::string  getDMRRecorderPath() const;
+  bool         getDMRRecorderSlot1() const;
+  bool         getDMRRecorderSlot2() const;
+  std::vector<unsigned int> getDMRRecorderTalkGroups() const;
 
   // The System Fusion section
   bool         getFusionEnabled() const;
@@ -122,6 +136,9 @@ private:
   std::string  m_logRoot;
   bool         m_logDisplay;
 
+  bool         m_captureEnabled;
+  unsigned int m_captureMinutes;
+
   std::string  m_modemPort;
   bool         m_modemRXInvert;
   bool         m_modemTXInvert;
@@ -130,6 +147,7 @@ private:
   unsigned int m_modemRXLevel;
   unsigned int m_modemTXLevel;
   bool         m_modemDebug;
+  unsigned int m_modemFramesPerTick;
 
   bool         m_dstarEnabled;
   std::string  m_dstarModule;
@@ -138,6 +156,13 @@ private:
   bool         m_dmrBeacons;
   unsigned int m_dmrId;
   unsigned int m_dmrColorCode;
+  bool         m_dmrDebug;
+
+  bool         m_dmrRecorderEnabled;
+  std::string  m_dmrRecorderPath;
+  bool         m_dmrRecorderSlot1;
+  bool         m_dmrRecorderSlot2;
+  std::vector<unsigned int> m_dmrRecorderTalkGroups;
 
   bool         m_fusionEnabled;
 
@@ -18,18 +18,21 @@
 
 #include <cassert>
 
-CDMRControl::CDMRControl(unsigned int id, unsigned int colorCode, unsigned int timeout, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display) :
+CDMRControl::CDMRControl(unsigned int id, unsigned int colorCode, unsigned int timeout, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display, CDMRRecorder* recorder, bool debug) :
 m_id(id),
 m_colorCode(colorCode),
 m_modem(modem),
 m_network(network),
 m_slot1(1U, timeout),
-m_slot2(2U, timeout)
+m_slot2(2U, timeout),
+m_netFrames(0U),
+m_netTicks(0U),
+m_netMaxFrames(0U)
 {
 	assert(modem != NULL);
 	assert(display != NULL);
 
-	CDMRSlot::init(colorCode, modem, network, display);
+	CDMRSlot::init(colorCode, modem, network, display, recorder, debug);
 }
 
 CDMRControl::~CDMRControl()
@@ -60,14 +63,14 @@ bool CDMRControl::processWakeup(const unsigned char* data)
 	return false;
 }
 
-void CDMRControl::writeModemSlot1(unsigned char *data)
+void CDMRControl::writeModemSlot1(CDMRFrame& frame)
 {
-	m_slot1.writeModem(data);
+	m_slot1.writeModem(frame);
 }
 
-void CDMRControl::writeModemSlot2(unsigned char *data)
+void CDMRControl::writeModemSlot2(CDMRFrame& frame)
 {
-	m_slot2.writeModem(data);
+	m_slot2.writeModem(frame);
 }
 
 unsigned int CDMRControl::readModemSlot1(unsigned char *data)
@@ -83,20 +86,45 @@ unsigned int CDMRControl::readModemSlot2(unsigned char *data)
 void CDMRControl::clock(unsigned int ms)
 {
 	if (m_network != NULL) {
+		// Read from the socket first so that a packet which woke the main loop is handled straight away
+		m_network->clock(ms);
+
+		// Hand every waiting frame to its slot, so that neither slot waits on the other
+		unsigned int frames = 0U;
+
 		CDMRData data;
-		bool ret = m_network->read(data);
-		if (ret) {
+		while (m_network->read(data)) {
 			unsigned int slotNo = data.getSlotNo();
 			switch (slotNo) {
 				case 1U: m_slot1.writeNetwork(data); break;
 				case 2U: m_slot2.writeNetwork(data); break;
 				default: LogError("Invalid slot no %u", slotNo); break;
 			}
+
+			frames++;
 		}
 
-		m_network->clock(ms);
+		if (frames > 0U) {
+			m_netFrames += frames;
+			m_netTicks++;
+			if (frames > m_netMaxFrames)
+				m_netMaxFrames = frames;
+		}
 	}
 
 	m_slot1.clock(ms);
 	m_slot2.clock(ms);
 }
+
+void CDMRControl::printStats()
+{
+	if (m_netTicks > 0U)
+		LogDebug("DMR network frames: %u in %u ticks, maximum %u/tick", m_netFrames, m_netTicks, m_netMaxFrames);
+
+	m_netFrames    = 0U;
+	m_netTicks     = 0U;
+	m_netMaxFrames = 0U;
+
+	m_slot1.printStats();
+	m_slot2.printStats();
+}
@@ -20,6 +20,7 @@
 #define	DMRControl_H
 
 #include "HomebrewDMRIPSC.h"
+#include "DMRRecorder.h"
 #include "Display.h"
 #include "DMRSlot.h"
 #include "DMRData.h"
@@ -28,19 +29,21 @@
 
 class CDMRControl {
 public:
-	CDMRControl(unsigned int id, unsigned int colorCode, unsigned int timeout, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display);
+	CDMRControl(unsigned int id, unsigned int colorCode, unsigned int timeout, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display, CDMRRecorder* recorder, bool debug);
 	~CDMRControl();
 
 	bool processWakeup(const unsigned char* data);
 
-	void writeModemSlot1(unsigned char* data);
-	void writeModemSlot2(unsigned char* data);
+	void writeModemSlot1(CDMRFrame& frame);
+	void writeModemSlot2(CDMRFrame& frame);
 
 	unsigned int readModemSlot1(unsigned char* data);
 	unsigned int readModemSlot2(unsigned char* data);
 
 	void clock(unsigned int ms);
 
+	void printStats();
+
 private:
 	unsigned int      m_id;
 	unsigned int      m_colorCode;
@@ -48,6 +51,9 @@ private:
 	CHomebrewDMRIPSC* m_network;
 	CDMRSlot          m_slot1;
 	CDMRSlot          m_slot2;
+	unsigned int      m_netFrames;
+	unsigned int      m_netTicks;
+	unsigned int      m_netMaxFrames;
 };
 
 #endif
@@ -19,11 +19,12 @@
 #include <cstdio>
 #include <cstring>
 #include <cassert>
+#include <utility>
 
 
 CDMRData::CDMRData(const CDMRData& data) :
 m_slotNo(data.m_slotNo),
-m_data(NULL),
+m_frame(data.m_frame),
 m_srcId(data.m_srcId),
 m_dstId(data.m_dstId),
 m_flco(data.m_flco),
@@ -31,13 +32,27 @@ m_dataType(data.m_dataType),
 m_seqNo(data.m_seqNo),
 m_n(data.m_n)
 {
-	m_data = new unsigned char[2U * DMR_FRAME_LENGTH_BYTES];
-	::memcpy(m_data, data.m_data, 2U * DMR_FRAME_LENGTH_BYTES);
+	if (m_frame.isEmpty())
+		::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
+}
+
+CDMRData::CDMRData(CDMRData&& data) :
+m_slotNo(data.m_slotNo),
+m_frame(std::move(data.m_frame)),
+m_srcId(data.m_srcId),
+m_dstId(data.m_dstId),
+m_flco(data.m_flco),
+m_dataType(data.m_dataType),
+m_seqNo(data.m_seqNo),
+m_n(data.m_n)
+{
+	if (m_frame.isEmpty())
+		::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
 }
 
 CDMRData::CDMRData() :
 m_slotNo(1U),
-m_data(NULL),
+m_frame(),
 m_srcId(0U),
 m_dstId(0U),
 m_flco(FLCO_GROUP),
@@ -45,19 +60,36 @@ m_dataType(0U),
 m_seqNo(0U),
 m_n(0U)
 {
-	m_data = new unsigned char[2U * DMR_FRAME_LENGTH_BYTES];
+	::memset(m_data, 0x00U, DMR_FRAME_LENGTH_BYTES);
 }
 
 CDMRData::~CDMRData()
 {
-	delete[] m_data;
 }
 
 CDMRData& CDMRData::operator=(const CDMRData& data)
 {
 	if (this != &data) {
-		::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
+		m_frame    = data.m_frame;
+		m_slotNo   = data.m_slotNo;
+		m_srcId    = data.m_srcId;
+		m_dstId    = data.m_dstId;
+		m_flco     = data.m_flco;
+		m_dataType = data.m_dataType;
+		m_seqNo    = data.m_seqNo;
+		m_n        = data.m_n;
+
+		if (m_frame.isEmpty())
+			::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
+	}
 
+	return *this;
+}
+
+CDMRData& CDMRData::operator=(CDMRData&& data)
+{
+	if (this != &data) {
+		m_frame    = std::move(data.m_frame);
 		m_slotNo   = data.m_slotNo;
 		m_srcId    = data.m_srcId;
 		m_dstId    = data.m_dstId;
@@ -65,6 +97,9 @@ CDMRData& CDMRData::operator=(const CDMRData& data)
 		m_dataType = data.m_dataType;
 		m_seqNo    = data.m_seqNo;
 		m_n        = data.m_n;
+
+		if (m_frame.isEmpty())
+			::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
 	}
 
 	return *this;
@@ -146,7 +181,8 @@ unsigned int CDMRData::getData(unsigned char* buffer) const
 {
 	assert(buffer != NULL);
 
-	::memcpy(buffer, m_data, DMR_FRAME_LENGTH_BYTES);
+	::memcpy(buffer, getData(), DMR_FRAME_LENGTH_BYTES);
+	CDMRFrame::countCopy(DCH_NETWORK);
 
 	return DMR_FRAME_LENGTH_BYTES;
 }
@@ -155,5 +191,25 @@ void CDMRData::setData(const unsigned char* buffer)
 {
 	assert(buffer != NULL);
 
+	// Held inline, never written into a frame that the slot may still be using
+	m_frame.release();
+
 	::memcpy(m_data, buffer, DMR_FRAME_LENGTH_BYTES);
+	CDMRFrame::countCopy(DCH_NETWORK);
+}
+
+void CDMRData::setData(const CDMRFrame& frame)
+{
+	assert(!frame.isEmpty());
+
+	m_frame = frame;
+}
+
+const unsigned char* CDMRData::getData() const
+{
+	if (m_frame.isEmpty())
+		return m_data;
+
+	// Skip the tag and flag
+	return m_frame.getData() + 2U;
 }
@@ -15,14 +15,17 @@
 #define	DMRData_H
 
 #include "DMRDefines.h"
+#include "DMRFrame.h"
 
 class CDMRData {
 public:
 	CDMRData(const CDMRData& data);
+	CDMRData(CDMRData&& data);
 	CDMRData();
 	~CDMRData();
 
 	CDMRData& operator=(const CDMRData& data);
+	CDMRData& operator=(CDMRData&& data);
 
 	unsigned int getSlotNo() const;
 	void setSlotNo(unsigned int slotNo);
@@ -48,9 +51,14 @@ public:
 	void setData(const unsigned char* buffer);
 	unsigned int getData(unsigned char* buffer) const;
 
+	// Shares the frame received from the modem rather than copying it
+	void setData(const CDMRFrame& frame);
+	const unsigned char* getData() const;
+
 private:
 	unsigned int   m_slotNo;
-	unsigned char* m_data;
+	unsigned char  m_data[DMR_FRAME_LENGTH_BYTES];
+	CDMRFrame      m_frame;
 	unsigned int   m_srcId;
 	unsigned int   m_dstId;
 	FLCO           m_flco;
@@ -0,0 +1,300 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRFrame.h"
+#include "Log.h"
+
+#include <chrono>
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+// Enough for both slots' transmit queues and the modem's receive queues to be full
+const unsigned int POOL_SIZE = 160U;
+
+const char* HOP_NAMES[] = {"modem", "slot queue", "network"};
+
+CDMRFrame::DMR_BUFFER* CDMRFrame::m_free = NULL;
+
+static bool         s_init      = false;
+static unsigned int s_inUse     = 0U;
+static unsigned int s_maxInUse  = 0U;
+static unsigned int s_allocated = 0U;
+static unsigned int s_poolMiss  = 0U;
+static unsigned int s_copies[DCH_COUNT];
+
+CDMRFrame::CDMRFrame() :
+m_buffer(NULL)
+{
+}
+
+CDMRFrame::CDMRFrame(const CDMRFrame& frame) :
+m_buffer(frame.m_buffer)
+{
+	if (m_buffer != NULL)
+		m_buffer->m_refs++;
+}
+
+CDMRFrame::CDMRFrame(CDMRFrame&& frame) :
+m_buffer(frame.m_buffer)
+{
+	frame.m_buffer = NULL;
+}
+
+CDMRFrame::~CDMRFrame()
+{
+	release();
+}
+
+CDMRFrame& CDMRFrame::operator=(const CDMRFrame& frame)
+{
+	if (m_buffer != frame.m_buffer) {
+		release();
+
+		m_buffer = frame.m_buffer;
+		if (m_buffer != NULL)
+			m_buffer->m_refs++;
+	}
+
+	return *this;
+}
+
+CDMRFrame& CDMRFrame::operator=(CDMRFrame&& frame)
+{
+	if (this != &frame) {
+		release();
+
+		m_buffer = frame.m_buffer;
+		frame.m_buffer = NULL;
+	}
+
+	return *this;
+}
+
+void CDMRFrame::create()
+{
+	release();
+
+	m_buffer = allocate();
+}
+
+void CDMRFrame::release()
+{
+	if (m_buffer == NULL)
+		return;
+
+	assert(m_buffer->m_refs > 0U);
+
+	m_buffer->m_refs--;
+	if (m_buffer->m_refs == 0U)
+		deallocate(m_buffer);
+
+	m_buffer = NULL;
+}
+
+bool CDMRFrame::isEmpty() const
+{
+	return m_buffer == NULL;
+}
+
+bool CDMRFrame::isShared() const
+{
+	return m_buffer != NULL && m_buffer->m_refs > 1U;
+}
+
+const unsigned char* CDMRFrame::getData() const
+{
+	assert(m_buffer != NULL);
+
+	return m_buffer->m_data;
+}
+
+unsigned char* CDMRFrame::getData()
+{
+	assert(m_buffer != NULL);
+
+	return m_buffer->m_data;
+}
+
+unsigned int CDMRFrame::getLength() const
+{
+	assert(m_buffer != NULL);
+
+	return m_buffer->m_length;
+}
+
+void CDMRFrame::setLength(unsigned int length)
+{
+	assert(m_buffer != NULL);
+	assert(length <= DMR_FRAME_LENGTH_BYTES + 2U);
+
+	m_buffer->m_length = length;
+}
+
+static unsigned long long getTime()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CDMRFrame::setTime()
+{
+	assert(m_buffer != NULL);
+
+	m_buffer->m_time = getTime();
+}
+
+unsigned int CDMRFrame::getAge() const
+{
+	assert(m_buffer != NULL);
+
+	if (m_buffer->m_time == 0U)
+		return 0U;
+
+	return (unsigned int)(getTime() - m_buffer->m_time);
+}
+
+void CDMRFrame::countCopy(DMR_COPY_HOP hop)
+{
+	assert(hop < DCH_COUNT);
+
+	s_copies[hop]++;
+}
+
+void CDMRFrame::printStats()
+{
+	if (s_allocated > 0U) {
+		LogDebug("DMR frames: %u allocated, %u from the heap, maximum %u in use", s_allocated, s_poolMiss, s_maxInUse);
+		LogDebug("DMR frame copies: %s %u, %s %u, %s %u", HOP_NAMES[DCH_MODEM], s_copies[DCH_MODEM], HOP_NAMES[DCH_SLOT_QUEUE], s_copies[DCH_SLOT_QUEUE], HOP_NAMES[DCH_NETWORK], s_copies[DCH_NETWORK]);
+	}
+
+	s_maxInUse  = s_inUse;
+	s_allocated = 0U;
+	s_poolMiss  = 0U;
+
+	for (unsigned int i = 0U; i < DCH_COUNT; i++)
+		s_copies[i] = 0U;
+}
+
+CDMRFrame::DMR_BUFFER* CDMRFrame::allocate()
+{
+	if (!s_init) {
+		static DMR_BUFFER pool[POOL_SIZE];
+
+		for (unsigned int i = 0U; i < POOL_SIZE; i++) {
+			pool[i].m_pooled = true;
+			pool[i].m_next   = m_free;
+			m_free = pool + i;
+		}
+
+		s_init = true;
+	}
+
+	DMR_BUFFER* buffer = m_free;
+	if (buffer != NULL) {
+		m_free = buffer->m_next;
+	} else {
+		buffer = new DMR_BUFFER;
+		buffer->m_pooled = false;
+		s_poolMiss++;
+	}
+
+	buffer->m_length = 0U;
+	buffer->m_time   = 0U;
+	buffer->m_refs   = 1U;
+	buffer->m_next   = NULL;
+
+	s_allocated++;
+	s_inUse++;
+	if (s_inUse > s_maxInUse)
+		s_maxInUse = s_inUse;
+
+	return buffer;
+}
+
+void CDMRFrame::deallocate(DMR_BUFFER* buffer)
+{
+	assert(buffer != NULL);
+
+	s_inUse--;
+
+	if (buffer->m_pooled) {
+		buffer->m_next = m_free;
+		m_free = buffer;
+	} else {
+		delete buffer;
+	}
+}
+
+CDMRFrameQueue::CDMRFrameQueue(unsigned int frames) :
+m_length(frames + 1U),
+m_frames(NULL),
+m_iPtr(0U),
+m_oPtr(0U)
+{
+	assert(frames > 0U);
+
+	m_frames = new CDMRFrame[m_length];
+}
+
+CDMRFrameQueue::~CDMRFrameQueue()
+{
+	delete[] m_frames;
+}
+
+bool CDMRFrameQueue::add(const CDMRFrame& frame)
+{
+	unsigned int iPtr = m_iPtr + 1U;
+	if (iPtr == m_length)
+		iPtr = 0U;
+
+	if (iPtr == m_oPtr)
+		return false;
+
+	m_frames[m_iPtr] = frame;
+	m_iPtr = iPtr;
+
+	return true;
+}
+
+bool CDMRFrameQueue::get(CDMRFrame& frame)
+{
+	if (m_oPtr == m_iPtr)
+		return false;
+
+	frame = std::move(m_frames[m_oPtr]);
+
+	m_oPtr++;
+	if (m_oPtr == m_length)
+		m_oPtr = 0U;
+
+	return true;
+}
+
+unsigned int CDMRFrameQueue::depth() const
+{
+	if (m_iPtr >= m_oPtr)
+		return m_iPtr - m_oPtr;
+
+	return m_length - (m_oPtr - m_iPtr);
+}
+
+bool CDMRFrameQueue::isEmpty() const
+{
+	return m_oPtr == m_iPtr;
+}
@@ -0,0 +1,114 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRFrame_H)
+#define	DMRFrame_H
+
+#include "DMRDefines.h"
+
+// The places where a DMR frame may be copied on its way through the host
+enum DMR_COPY_HOP {
+	DCH_MODEM,
+	DCH_SLOT_QUEUE,
+	DCH_NETWORK,
+	DCH_COUNT
+};
+
+// A reference counted DMR frame, the tag, the flag and then the frame itself.
+// Copying a CDMRFrame shares the buffer, so a frame received from the modem
+// can be handed to the slot and then to the network without its bytes being
+// copied. Buffers come from a fixed pool and fall back to the heap when the
+// pool is exhausted. Only for use from the main thread.
+class CDMRFrame {
+public:
+	CDMRFrame();
+	CDMRFrame(const CDMRFrame& frame);
+	CDMRFrame(CDMRFrame&& frame);
+	~CDMRFrame();
+
+	CDMRFrame& operator=(const CDMRFrame& frame);
+	CDMRFrame& operator=(CDMRFrame&& frame);
+
+	// Gives this frame a buffer of its own, the contents are undefined
+	void create();
+
+	void release();
+
+	bool isEmpty() const;
+	bool isShared() const;
+
+	// Writing to a frame also changes every frame that shares its buffer
+	const unsigned char* getData() const;
+	unsigned char* getData();
+
+	unsigned int getLength() const;
+	void setLength(unsigned int length);
+
+	// Marks when the frame was received from the modem, or queued by a slot,
+	// getAge() is then the time since in microseconds, or zero if it was never
+	// marked
+	void setTime();
+	unsigned int getAge() const;
+
+	static void countCopy(DMR_COPY_HOP hop);
+
+	static void printStats();
+
+private:
+	struct DMR_BUFFER {
+		unsigned char m_data[DMR_FRAME_LENGTH_BYTES + 2U];
+		unsigned int  m_length;
+		unsigned long long m_time;
+		unsigned int  m_refs;
+		bool          m_pooled;
+		DMR_BUFFER*   m_next;
+	};
+
+	DMR_BUFFER* m_buffer;
+
+	static DMR_BUFFER* m_free;
+
+	static DMR_BUFFER* allocate();
+	static void deallocate(DMR_BUFFER* buffer);
+};
+
+// A fixed length queue of shared frames
+class CDMRFrameQueue {
+public:
+	CDMRFrameQueue(unsigned int frames);
+	~CDMRFrameQueue();
+
+	bool add(const CDMRFrame& frame);
+
+	bool get(CDMRFrame& frame);
+
+	unsigned int depth() const;
+
+	bool isEmpty() const;
+
+private:
+	unsigned int m_length;
+	CDMRFrame*   m_frames;
+	unsigned int m_iPtr;
+	unsigned int m_oPtr;
+
+	CDMRFrameQueue(const CDMRFrameQueue&);
+	CDMRFrameQueue& operator=(const CDMRFrameQueue&);
+};
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRRecorder.h"
+#include "DMRDefines.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <cassert>
+#include <cstring>
+#include <ctime>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Nearly a minute of both slots, the writer normally keeps it almost empty
+const unsigned int RECORDER_QUEUE_LENGTH = 64U * 1024U;
+
+// Each file is written through a buffer this size, a minute of one slot fits
+const unsigned int RECORDER_BUFFER_LENGTH = 64U * 1024U;
+
+// Two minutes of one slot is reserved on the disk when a file is opened
+const unsigned int RECORDER_PREALLOCATE = 128U * 1024U;
+
+const unsigned int RECORDER_FRAME_LENGTH = DMR_FRAME_LENGTH_BYTES + 2U;
+
+// Queued records start with the command and the slot number
+const unsigned char RECORDER_START = 0x01U;
+const unsigned char RECORDER_DATA  = 0x02U;
+const unsigned char RECORDER_END   = 0x03U;
+
+CDMRRecorder::CDMRRecorder(const std::string& path, bool slot1, bool slot2, const std::vector<unsigned int>& talkGroups) :
+m_path(path),
+m_talkGroups(talkGroups),
+m_queue(RECORDER_QUEUE_LENGTH),
+m_thread(NULL),
+m_mutex(),
+m_cond(),
+m_running(false)
+{
+	m_enabled[0U] = slot1;
+	m_enabled[1U] = slot2;
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		m_recording[i] = false;
+		m_dropped[i]   = 0U;
+		m_fp[i]        = NULL;
+		m_written[i]   = 0U;
+	}
+}
+
+CDMRRecorder::~CDMRRecorder()
+{
+}
+
+bool CDMRRecorder::open()
+{
+	m_running = true;
+	m_thread  = new std::thread(&CDMRRecorder::writer, this);
+
+	return true;
+}
+
+void CDMRRecorder::start(unsigned int slotNo, unsigned int srcId, unsigned int dstId, bool group)
+{
+	assert(slotNo == 1U || slotNo == 2U);
+
+	unsigned int n = slotNo - 1U;
+
+	if (m_recording[n])
+		end(slotNo);
+
+	if (!m_enabled[n])
+		return;
+
+	if (!m_talkGroups.empty()) {
+		if (!group || std::find(m_talkGroups.begin(), m_talkGroups.end(), dstId) == m_talkGroups.end())
+			return;
+	}
+
+	unsigned char record[20U];
+	record[0U] = RECORDER_START;
+	record[1U] = slotNo;
+
+	long long t = (long long)::time(NULL);
+	::memcpy(record + 2U, &t, sizeof(long long));
+	::memcpy(record + 10U, &srcId, sizeof(unsigned int));
+	::memcpy(record + 14U, &dstId, sizeof(unsigned int));
+	record[18U] = group ? 1U : 0U;
+
+	if (!m_queue.addFrame(record, 19U))
+		return;
+
+	m_recording[n] = true;
+	m_dropped[n]   = 0U;
+}
+
+void CDMRRecorder::write(unsigned int slotNo, const unsigned char* data)
+{
+	assert(slotNo == 1U || slotNo == 2U);
+	assert(data != NULL);
+
+	unsigned int n = slotNo - 1U;
+
+	if (!m_recording[n])
+		return;
+
+	unsigned char record[RECORDER_FRAME_LENGTH + 2U];
+	record[0U] = RECORDER_DATA;
+	record[1U] = slotNo;
+	::memcpy(record + 2U, data, RECORDER_FRAME_LENGTH);
+
+	if (!m_queue.addFrame(record, RECORDER_FRAME_LENGTH + 2U))
+		m_dropped[n]++;
+}
+
+void CDMRRecorder::end(unsigned int slotNo)
+{
+	assert(slotNo == 1U || slotNo == 2U);
+
+	unsigned int n = slotNo - 1U;
+
+	if (!m_recording[n])
+		return;
+
+	unsigned char record[2U];
+	record[0U] = RECORDER_END;
+	record[1U] = slotNo;
+
+	// If this is lost the next start closes the file
+	m_queue.addFrame(record, 2U);
+
+	if (m_dropped[n] > 0U)
+		LogWarning("DMR Slot %u, the recorder is behind, %u frames have been dropped", slotNo, m_dropped[n]);
+
+	m_recording[n] = false;
+}
+
+void CDMRRecorder::close()
+{
+	if (m_thread == NULL)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+
+	m_cond.notify_one();
+
+	m_thread->join();
+	delete m_thread;
+	m_thread = NULL;
+
+	for (unsigned int i = 0U; i < 2U; i++)
+		closeFile(i + 1U);
+}
+
+void CDMRRecorder::writer()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (m_running) {
+		lock.unlock();
+		bool data = drain();
+		lock.lock();
+
+		// The slots never wake the writer, a few frames are written at a time
+		if (m_running && !data)
+			m_cond.wait_for(lock, std::chrono::milliseconds(200));
+	}
+
+	lock.unlock();
+	drain();
+}
+
+bool CDMRRecorder::drain()
+{
+	bool data = false;
+
+	unsigned char record[256U];
+	unsigned int length;
+	while ((length = m_queue.getFrame(record)) > 0U) {
+		unsigned int slotNo = record[1U];
+
+		switch (record[0U]) {
+			case RECORDER_START:
+				openFile(record);
+				break;
+			case RECORDER_DATA:
+				writeFile(slotNo, record + 2U);
+				break;
+			default:
+				closeFile(slotNo);
+				break;
+		}
+
+		data = true;
+	}
+
+	return data;
+}
+
+void CDMRRecorder::openFile(const unsigned char* record)
+{
+	unsigned int slotNo = record[1U];
+
+	closeFile(slotNo);
+
+	long long t;
+	unsigned int srcId, dstId;
+	::memcpy(&t, record + 2U, sizeof(long long));
+	::memcpy(&srcId, record + 10U, sizeof(unsigned int));
+	::memcpy(&dstId, record + 14U, sizeof(unsigned int));
+	bool group = record[18U] == 1U;
+
+	time_t now = time_t(t);
+
+	// The log writer thread uses gmtime() too
+	struct tm tm;
+#if defined(_WIN32) || defined(_WIN64)
+	::gmtime_s(&tm, &now);
+#else
+	::gmtime_r(&now, &tm);
+#endif
+
+	char name[200U];
+#if defined(_WIN32) || defined(_WIN64)
+	::sprintf(name, "%s\\DMR_%u_%04d%02d%02d_%02d%02d%02d_%u_%s%u.ambe", m_path.c_str(), slotNo, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, srcId, group ? "TG" : "", dstId);
+#else
+	::sprintf(name, "%s/DMR_%u_%04d%02d%02d_%02d%02d%02d_%u_%s%u.ambe", m_path.c_str(), slotNo, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, srcId, group ? "TG" : "", dstId);
+#endif
+
+	FILE* fp = ::fopen(name, "wb");
+	if (fp == NULL) {
+		LogError("Cannot open the recording %s", name);
+		return;
+	}
+
+	// Let the buffer fill before anything reaches the disk
+	::setvbuf(fp, NULL, _IOFBF, RECORDER_BUFFER_LENGTH);
+
+#if defined(__linux__)
+	// Reserve space up front so that the file isn't fragmented by the other slot, the size stays as written
+	::fallocate(::fileno(fp), FALLOC_FL_KEEP_SIZE, 0, RECORDER_PREALLOCATE);
+#endif
+
+	::fwrite("DMR", 1U, 3U, fp);
+
+	m_fp[slotNo - 1U]      = fp;
+	m_written[slotNo - 1U] = 0U;
+
+	LogMessage("DMR Slot %u, recording to %s", slotNo, name);
+}
+
+void CDMRRecorder::writeFile(unsigned int slotNo, const unsigned char* data)
+{
+	FILE* fp = m_fp[slotNo - 1U];
+	if (fp == NULL)
+		return;
+
+	::fwrite(data, 1U, RECORDER_FRAME_LENGTH, fp);
+
+	m_written[slotNo - 1U]++;
+}
+
+void CDMRRecorder::closeFile(unsigned int slotNo)
+{
+	FILE* fp = m_fp[slotNo - 1U];
+	if (fp == NULL)
+		return;
+
+	::fflush(fp);
+
+#if defined(__linux__)
+	// Give back whatever was reserved beyond the end of the file
+	int ret = ::ftruncate(::fileno(fp), 3 + m_written[slotNo - 1U] * RECORDER_FRAME_LENGTH);
+	if (ret != 0)
+		LogWarning("DMR Slot %u, cannot release the space reserved for the recording", slotNo);
+#endif
+
+	::fclose(fp);
+
+	m_fp[slotNo - 1U] = NULL;
+}
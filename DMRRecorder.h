@@ -0,0 +1,81 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRRecorder_H)
+#define	DMRRecorder_H
+
+#include "SPSCRingBuffer.h"
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+// Records DMR voice transmissions to .ambe files, one per transmission. The
+// file starts with "DMR" followed by the frames as they are queued for the
+// modem, the tag, a flag and the frame itself, and can be sent again with
+// DMRReplay.
+//
+// The slot only queues the frames, a writer thread does the file I/O, so a
+// slow disk loses frames rather than holding up the slot.
+class CDMRRecorder {
+public:
+	// An empty list of talkgroups records every transmission on the chosen slots
+	CDMRRecorder(const std::string& path, bool slot1, bool slot2, const std::vector<unsigned int>& talkGroups);
+	~CDMRRecorder();
+
+	bool open();
+
+	// Called from the main thread by the slots, does nothing unless the transmission is wanted
+	void start(unsigned int slotNo, unsigned int srcId, unsigned int dstId, bool group);
+	void write(unsigned int slotNo, const unsigned char* data);
+	void end(unsigned int slotNo);
+
+	void close();
+
+private:
+	std::string                    m_path;
+	bool                           m_enabled[2U];
+	std::vector<unsigned int>      m_talkGroups;
+	bool                           m_recording[2U];
+	unsigned int                   m_dropped[2U];
+	CSPSCRingBuffer<unsigned char> m_queue;
+	std::thread*                   m_thread;
+	std::mutex                     m_mutex;
+	std::condition_variable        m_cond;
+	bool                           m_running;
+
+	// Only used by the writer thread
+	FILE*                          m_fp[2U];
+	unsigned int                   m_written[2U];
+
+	void writer();
+	bool drain();
+
+	void openFile(const unsigned char* record);
+	void writeFile(unsigned int slotNo, const unsigned char* data);
+	void closeFile(unsigned int slotNo);
+
+	CDMRRecorder(const CDMRRecorder&);
+	CDMRRecorder& operator=(const CDMRRecorder&);
+};
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Sends a recording made by the DMR recorder out through the modem named in
+// an MMDVMHost .ini file, on the slot it was recorded from unless another is
+// given. MMDVMHost must not be running as it needs the modem to itself.
+
+#include "DMRDefines.h"
+#include "StopWatch.h"
+#include "Modem.h"
+#include "Conf.h"
+#include "Log.h"
+
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+const unsigned int FRAME_LENGTH = DMR_FRAME_LENGTH_BYTES + 2U;
+
+// How long the modem is kept running once the last frame has been queued
+const unsigned int TAIL_MS = 2000U;
+
+static void sleepMS(unsigned int ms)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	::Sleep(ms);
+#else
+	::usleep(ms * 1000U);
+#endif
+}
+
+// The recorder names files DMR_<slot>_..., anything else is taken as slot 1
+static unsigned int getSlot(const char* path)
+{
+	const char* name = ::strrchr(path, '/');
+	const char* name2 = ::strrchr(path, '\\');
+	if (name2 > name)
+		name = name2;
+	name = (name == NULL) ? path : name + 1;
+
+	unsigned int slotNo;
+	if (::sscanf(name, "DMR_%u_", &slotNo) == 1 && (slotNo == 1U || slotNo == 2U))
+		return slotNo;
+
+	return 1U;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 3 && argc != 4) {
+		::fprintf(stderr, "Usage: DMRReplay <ini file> <recording> [<slot>]\n");
+		return 1;
+	}
+
+	unsigned int slotNo = (argc == 4) ? (unsigned int)::atoi(argv[3]) : getSlot(argv[2]);
+	if (slotNo != 1U && slotNo != 2U) {
+		::fprintf(stderr, "DMRReplay: the slot must be 1 or 2\n");
+		return 1;
+	}
+
+	FILE* fp = ::fopen(argv[2], "rb");
+	if (fp == NULL) {
+		::fprintf(stderr, "DMRReplay: cannot open %s\n", argv[2]);
+		return 1;
+	}
+
+	unsigned char header[3U];
+	if (::fread(header, 1U, 3U, fp) != 3U || ::memcmp(header, "DMR", 3U) != 0) {
+		::fprintf(stderr, "DMRReplay: %s is not a DMR recording\n", argv[2]);
+		::fclose(fp);
+		return 1;
+	}
+
+	std::vector<unsigned char> frames;
+	unsigned char frame[FRAME_LENGTH];
+	while (::fread(frame, 1U, FRAME_LENGTH, fp) == FRAME_LENGTH)
+		frames.insert(frames.end(), frame, frame + FRAME_LENGTH);
+
+	::fclose(fp);
+
+	unsigned int count = frames.size() / FRAME_LENGTH;
+	if (count == 0U) {
+		::fprintf(stderr, "DMRReplay: %s has no frames\n", argv[2]);
+		return 1;
+	}
+
+	CConf conf(argv[1]);
+	if (!conf.read()) {
+		::fprintf(stderr, "DMRReplay: cannot read the .ini file\n");
+		return 1;
+	}
+
+	// Logged alongside MMDVMHost but under a name of its own
+	if (!::LogInitialise(conf.getLogPath(), "DMRReplay", true)) {
+		::fprintf(stderr, "DMRReplay: unable to open the log file\n");
+		return 1;
+	}
+
+	::LogSetLevel(conf.getLogLevel());
+
+	CModem modem(conf.getModemPort(), conf.getModemRXInvert(), conf.getModemTXInvert(), conf.getModemPTTInvert(), conf.getModemTXDelay(), conf.getModemRXLevel(), conf.getModemTXLevel(), conf.getModemDebug());
+	modem.setModeParams(false, true, false);
+	modem.setDMRParams(conf.getDMRColorCode());
+	modem.setFramesPerTick(conf.getModemFramesPerTick());
+
+	if (!modem.open()) {
+		::LogFinalise();
+		return 1;
+	}
+
+	LogMessage("Sending %u frames from %s on slot %u", count, argv[2], slotNo);
+
+	// This sets the mode to DMR within the modem
+	modem.writeDMRStart(true);
+
+	CStopWatch stopWatch;
+	stopWatch.start();
+
+	unsigned int n = 0U;
+	unsigned int rejected = 0U;
+	unsigned int tail = 0U;
+	while (tail < TAIL_MS) {
+		unsigned int ms = stopWatch.elapsed();
+		stopWatch.start();
+
+		modem.clock(ms);
+
+		// Anything received is thrown away so that the modem's queues don't fill
+		CDMRFrame rxFrame;
+		while (modem.readDMRData1(rxFrame))
+			;
+		while (modem.readDMRData2(rxFrame))
+			;
+
+		while (n < count && (slotNo == 1U ? modem.hasDMRSpace1() : modem.hasDMRSpace2())) {
+			const unsigned char* data = &frames[n * FRAME_LENGTH];
+
+			bool ret = (slotNo == 1U) ? modem.writeDMRData1(data, FRAME_LENGTH) : modem.writeDMRData2(data, FRAME_LENGTH);
+			if (!ret)
+				rejected++;
+
+			n++;
+		}
+
+		if (n == count)
+			tail += ms;
+
+		sleepMS(5U);
+	}
+
+	modem.writeDMRStart(false);
+
+	modem.close();
+
+	if (rejected > 0U)
+		LogWarning("%u frames were not accepted by the modem", rejected);
+
+	LogMessage("Sent %u frames", count - rejected);
+
+	::LogFinalise();
+
+	return 0;
+}
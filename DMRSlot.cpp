@@ -22,6 +22,8 @@
 #include "CRC.h"
 #include "Log.h"
 
+#include <algorithm>
+
 #include <cassert>
 #include <ctime>
 
@@ -29,6 +31,7 @@ unsigned int      CDMRSlot::m_colorCode = 0U;
 CModem*           CDMRSlot::m_modem = NULL;
 CHomebrewDMRIPSC* CDMRSlot::m_network = NULL;
 IDisplay*         CDMRSlot::m_display = NULL;
+CDMRRecorder*     CDMRSlot::m_recorder = NULL;
 
 unsigned char*    CDMRSlot::m_idle = NULL;
 
@@ -37,14 +40,29 @@ unsigned char     CDMRSlot::m_id1 = 0U;
 FLCO              CDMRSlot::m_flco2;
 unsigned char     CDMRSlot::m_id2 = 0U;
 
-// #define	DUMP_DMR
+bool              CDMRSlot::m_debug = false;
+
+// There are only a few talkgroups and users active at a time
+const unsigned int SHORT_LC_CACHE_SIZE = 16U;
+
+CDMRSlot::SHORT_LC_ENTRY CDMRSlot::m_shortLCs[SHORT_LC_CACHE_SIZE];
+
+// Three seconds of frames, a burst from the network arrives all at once
+const unsigned int QUEUE_FRAMES = 50U;
+
+// More than a minute of RF frames on one slot, the interval between statistics
+const unsigned int LATENCY_SAMPLES = 1200U;
 
 CDMRSlot::CDMRSlot(unsigned int slotNo, unsigned int timeout) :
 m_slotNo(slotNo),
-m_queue(1000U),
+m_queue(QUEUE_FRAMES),
+m_queueMaxDepth(0U),
+m_queueMaxAge(0U),
+m_queueLate(0U),
+m_latencies(),
 m_state(RS_LISTENING),
 m_embeddedLC(),
-m_lc(NULL),
+m_lc(),
 m_seqNo(0U),
 m_n(0U),
 m_lastFrame(NULL),
@@ -56,10 +74,11 @@ m_frames(0U),
 m_lost(0U),
 m_fec(),
 m_bits(0U),
-m_errs(0U),
-m_fp(NULL)
+m_errs(0U)
 {
 	m_lastFrame = new unsigned char[DMR_FRAME_LENGTH_BYTES + 2U];
+
+	m_latencies.reserve(LATENCY_SAMPLES);
 }
 
 CDMRSlot::~CDMRSlot()
@@ -67,8 +86,11 @@ CDMRSlot::~CDMRSlot()
 	delete[] m_lastFrame;
 }
 
-void CDMRSlot::writeModem(unsigned char *data)
+void CDMRSlot::writeModem(CDMRFrame& frame)
 {
+	// The frame is modified in place and then shared with the network
+	unsigned char* data = frame.getData();
+
 	if (data[0U] == TAG_LOST && m_state == RS_RELAYING_RF_AUDIO) {
 		LogMessage("DMR Slot %u, transmission lost, BER: %u%%", m_slotNo, (m_errs * 100U) / m_bits);
 		writeEndOfTransmission();
@@ -103,12 +125,14 @@ void CDMRSlot::writeModem(unsigned char *data)
 				return;
 
 			CFullLC fullLC;
-			m_lc = fullLC.decode(data + 2U, DT_VOICE_LC_HEADER);
-			if (m_lc == NULL) {
+			if (!fullLC.decode(data + 2U, DT_VOICE_LC_HEADER, m_lc)) {
 				LogMessage("DMR Slot %u: unable to decode the LC", m_slotNo);
 				return;
 			}
 
+			// Pass on the LC as corrected, not as received
+			fullLC.encode(m_lc, data + 2U, DT_VOICE_LC_HEADER);
+
 			// Regenerate the Slot Type
 			slotType.getData(data + 2U);
 
@@ -132,16 +156,19 @@ void CDMRSlot::writeModem(unsigned char *data)
 			writeQueue(m_idle);
 
 			for (unsigned i = 0U; i < 3U; i++) {
-				writeNetwork(data, DT_VOICE_LC_HEADER);
+				writeNetwork(frame, DT_VOICE_LC_HEADER);
 				writeQueue(data);
 			}
 
 			m_state = RS_RELAYING_RF_AUDIO;
-			setShortLC(m_slotNo, m_lc->getDstId(), m_lc->getFLCO());
+			setShortLC(m_slotNo, m_lc.getDstId(), m_lc.getFLCO());
+
+			m_display->writeDMR(m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP, m_lc.getDstId());
 
-			m_display->writeDMR(m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP, m_lc->getDstId());
+			startRecording();
+			writeRecording(data);
 
-			LogMessage("DMR Slot %u, received RF voice header from %u to %s%u", m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP ? "TG " : "", m_lc->getDstId());
+			LogMessage("DMR Slot %u, received RF voice header from %u to %s%u", m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP ? "TG " : "", m_lc.getDstId());
 		} else if (dataType == DT_VOICE_PI_HEADER) {
 			if (m_state != RS_RELAYING_RF_AUDIO)
 				return;
@@ -158,12 +185,15 @@ void CDMRSlot::writeModem(unsigned char *data)
 
 			m_n = 0U;
 
-			writeNetwork(data, DT_VOICE_PI_HEADER);
+			writeNetwork(frame, DT_VOICE_PI_HEADER);
 			writeQueue(data);
+			writeRecording(data);
 		} else if (dataType == DT_TERMINATOR_WITH_LC) {
 			if (m_state != RS_RELAYING_RF_AUDIO)
 				return;
 
+			correctTerminator(data);
+
 			// Regenerate the Slot Type
 			slotType.getData(data + 2U);
 
@@ -174,8 +204,9 @@ void CDMRSlot::writeModem(unsigned char *data)
 			data[0U] = TAG_EOT;
 			data[1U] = 0x00U;
 
-			writeNetwork(data, DT_TERMINATOR_WITH_LC);
+			writeNetwork(frame, DT_TERMINATOR_WITH_LC);
 			writeQueue(data);
+			writeRecording(data);
 
 			LogMessage("DMR Slot %u, received RF end of voice transmission, BER: %u%%", m_slotNo, (m_errs * 100U) / m_bits);
 
@@ -207,16 +238,16 @@ void CDMRSlot::writeModem(unsigned char *data)
 			writeQueue(m_idle);
 
 			for (unsigned i = 0U; i < 3U; i++) {
-				writeNetwork(data, DT_DATA_HEADER);
+				writeNetwork(frame, DT_DATA_HEADER);
 				writeQueue(data);
 			}
 
 			m_state = RS_RELAYING_RF_DATA;
-			// setShortLC(m_slotNo, m_lc->getDstId(), m_lc->getFLCO());
+			// setShortLC(m_slotNo, m_lc.getDstId(), m_lc.getFLCO());
 
-			// m_display->writeDMR(m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP, m_lc->getDstId());
+			// m_display->writeDMR(m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP, m_lc.getDstId());
 
-			// LogMessage("DMR Slot %u, received RF data header from %u to %s%u", m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP ? "TG " : "", m_lc->getDstId());
+			// LogMessage("DMR Slot %u, received RF data header from %u to %s%u", m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP ? "TG " : "", m_lc.getDstId());
 			LogMessage("DMR Slot %u, received RF data header", m_slotNo);
 		} else {
 			// Regenerate the Slot Type
@@ -229,8 +260,9 @@ void CDMRSlot::writeModem(unsigned char *data)
 			data[0U] = TAG_DATA;
 			data[1U] = 0x00U;
 
-			writeNetwork(data, dataType);
+			writeNetwork(frame, dataType);
 			writeQueue(data);
+			writeRecording(data);
 		}
 	} else if (audioSync) {
 		if (m_state == RS_RELAYING_RF_AUDIO) {
@@ -238,10 +270,10 @@ void CDMRSlot::writeModem(unsigned char *data)
 			CDMRSync sync;
 			sync.addSync(data + 2U, DST_BS_AUDIO);
 
-			unsigned char fid = m_lc->getFID();
+			unsigned char fid = m_lc.getFID();
 			if (fid == FID_ETSI || fid == FID_DMRA)
 				m_errs += m_fec.regenerateDMR(data + 2U);
-			m_bits += 216U;
+			m_bits += 141U;
 
 			data[0U] = TAG_DATA;
 			data[1U] = 0x00U;
@@ -249,7 +281,8 @@ void CDMRSlot::writeModem(unsigned char *data)
 			m_n = 0U;
 
 			writeQueue(data);
-			writeNetwork(data, DT_VOICE_SYNC);
+			writeRecording(data);
+			writeNetwork(frame, DT_VOICE_SYNC);
 		} else if (m_state == RS_LISTENING) {
 			m_state = RS_LATE_ENTRY;
 		}
@@ -262,10 +295,10 @@ void CDMRSlot::writeModem(unsigned char *data)
 			emb.setColorCode(m_colorCode);
 			emb.getData(data + 2U);
 
-			unsigned char fid = m_lc->getFID();
+			unsigned char fid = m_lc.getFID();
 			if (fid == FID_ETSI || fid == FID_DMRA)
 				m_errs += m_fec.regenerateDMR(data + 2U);
-			m_bits += 216U;
+			m_bits += 141U;
 
 			data[0U] = TAG_DATA;
 			data[1U] = 0x00U;
@@ -273,15 +306,15 @@ void CDMRSlot::writeModem(unsigned char *data)
 			m_n++;
 
 			writeQueue(data);
-			writeNetwork(data, DT_VOICE);
+			writeRecording(data);
+			writeNetwork(frame, DT_VOICE);
 		} else if (m_state == RS_LATE_ENTRY) {
 			// If we haven't received an LC yet, then be strict on the color code
 			unsigned char colorCode = emb.getColorCode();
 			if (colorCode != m_colorCode)
 				return;
 
-			m_lc = m_embeddedLC.addData(data + 2U, emb.getLCSS());
-			if (m_lc != NULL) {
+			if (m_embeddedLC.addData(data + 2U, emb.getLCSS(), m_lc)) {
 				// Create a dummy start frame to replace the received frame
 				unsigned char start[DMR_FRAME_LENGTH_BYTES + 2U];
 
@@ -289,7 +322,7 @@ void CDMRSlot::writeModem(unsigned char *data)
 				sync.addSync(start + 2U, DST_BS_DATA);
 
 				CFullLC fullLC;
-				fullLC.encode(*m_lc, start + 2U, DT_VOICE_LC_HEADER);
+				fullLC.encode(m_lc, start + 2U, DT_VOICE_LC_HEADER);
 
 				CSlotType slotType;
 				slotType.setColorCode(m_colorCode);
@@ -317,10 +350,10 @@ void CDMRSlot::writeModem(unsigned char *data)
 				emb.getData(data + 2U);
 
 				// Send the original audio frame out
-				unsigned char fid = m_lc->getFID();
+				unsigned char fid = m_lc.getFID();
 				if (fid == FID_ETSI || fid == FID_DMRA)
 					m_errs += m_fec.regenerateDMR(data + 2U);
-				m_bits += 216U;
+				m_bits += 141U;
 
 				data[0U] = TAG_DATA;
 				data[1U] = 0x00U;
@@ -328,15 +361,19 @@ void CDMRSlot::writeModem(unsigned char *data)
 				m_n++;
 
 				writeQueue(data);
-				writeNetwork(data, DT_VOICE);
+				writeNetwork(frame, DT_VOICE);
 
 				m_state = RS_RELAYING_RF_AUDIO;
 
-				setShortLC(m_slotNo, m_lc->getDstId(), m_lc->getFLCO());
+				setShortLC(m_slotNo, m_lc.getDstId(), m_lc.getFLCO());
 
-				m_display->writeDMR(m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP, m_lc->getDstId());
+				m_display->writeDMR(m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP, m_lc.getDstId());
 
-				LogMessage("DMR Slot %u, received RF late entry from %u to %s%u", m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP ? "TG " : "", m_lc->getDstId());
+				startRecording();
+				writeRecording(start);
+				writeRecording(data);
+
+				LogMessage("DMR Slot %u, received RF late entry from %u to %s%u", m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP ? "TG " : "", m_lc.getDstId());
 			}
 		}
 	}
@@ -344,15 +381,20 @@ void CDMRSlot::writeModem(unsigned char *data)
 
 unsigned int CDMRSlot::readModem(unsigned char* data)
 {
-	if (m_queue.isEmpty())
+	CDMRFrame frame;
+	if (!m_queue.get(frame))
 		return 0U;
 
-	unsigned char len = 0U;
-	m_queue.getData(&len, 1U);
+	::memcpy(data, frame.getData(), DMR_FRAME_LENGTH_BYTES + 2U);
 
-	m_queue.getData(data, len);
+	// How long the frame waited, anything beyond a slot time means we are behind
+	unsigned int age = frame.getAge() / 1000U;
+	if (age > m_queueMaxAge)
+		m_queueMaxAge = age;
+	if (age > DMR_SLOT_TIME)
+		m_queueLate++;
 
-	return len;
+	return DMR_FRAME_LENGTH_BYTES + 2U;
 }
 
 void CDMRSlot::writeEndOfTransmission()
@@ -367,12 +409,7 @@ void CDMRSlot::writeEndOfTransmission()
 	m_timeoutTimer.stop();
 	m_packetTimer.stop();
 
-	delete m_lc;
-	m_lc = NULL;
-
-#if defined(DUMP_DMR)
-	closeFile();
-#endif
+	endRecording();
 }
 
 void CDMRSlot::writeNetwork(const CDMRData& dmrData)
@@ -392,12 +429,14 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 			return;
 
 		CFullLC fullLC;
-		m_lc = fullLC.decode(data + 2U, DT_VOICE_LC_HEADER);
-		if (m_lc == NULL) {
+		if (!fullLC.decode(data + 2U, DT_VOICE_LC_HEADER, m_lc)) {
 			LogMessage("DMR Slot %u, bad LC received from the network", m_slotNo);
 			return;
 		}
 
+		// Pass on the LC as corrected, not as received
+		fullLC.encode(m_lc, data + 2U, DT_VOICE_LC_HEADER);
+
 		// Regenerate the Slot Type
 		CSlotType slotType;
 		slotType.setColorCode(m_colorCode);
@@ -427,15 +466,14 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 
 		m_state = RS_RELAYING_NETWORK_AUDIO;
 
-		setShortLC(m_slotNo, m_lc->getDstId(), m_lc->getFLCO());
+		setShortLC(m_slotNo, m_lc.getDstId(), m_lc.getFLCO());
 
-		m_display->writeDMR(m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP, m_lc->getDstId());
+		m_display->writeDMR(m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP, m_lc.getDstId());
 
-#if defined(DUMP_DMR)
-		openFile();
-		writeFile(data);
-#endif
-		LogMessage("DMR Slot %u, received network voice header from %u to %s%u", m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP ? "TG " : "", m_lc->getDstId());
+		startRecording();
+		writeRecording(data);
+
+		LogMessage("DMR Slot %u, received network voice header from %u to %s%u", m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP ? "TG " : "", m_lc.getDstId());
 	} else if (dataType == DT_VOICE_PI_HEADER) {
 		if (m_state != RS_RELAYING_NETWORK_AUDIO)
 			return;
@@ -454,14 +492,13 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		data[1U] = 0x00U;
 
 		writeQueue(data);
-
-#if defined(DUMP_DMR)
-		writeFile(data);
-#endif
+		writeRecording(data);
 	} else if (dataType == DT_TERMINATOR_WITH_LC) {
 		if (m_state != RS_RELAYING_NETWORK_AUDIO)
 			return;
 
+		correctTerminator(data);
+
 		// Regenerate the Slot Type
 		CSlotType slotType;
 		slotType.setColorCode(m_colorCode);
@@ -476,12 +513,9 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		data[1U] = 0x00U;
 
 		writeQueue(data);
+		writeRecording(data);
 		writeEndOfTransmission();
 
-#if defined(DUMP_DMR)
-		writeFile(data);
-		closeFile();
-#endif
 		// We've received the voice header and terminator haven't we?
 		m_frames += 2U;
 		LogMessage("DMR Slot %u, received network end of voice transmission, %u%% packet loss, BER: %u%%", m_slotNo, (m_lost * 100U) / m_frames, (m_errs * 100U) / m_bits);
@@ -511,11 +545,11 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 
 		m_state = RS_RELAYING_NETWORK_DATA;
 
-		// setShortLC(m_slotNo, m_lc->getDstId(), m_lc->getFLCO());
+		// setShortLC(m_slotNo, m_lc.getDstId(), m_lc.getFLCO());
 
-		// m_display->writeDMR(m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP, m_lc->getDstId());
+		// m_display->writeDMR(m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP, m_lc.getDstId());
 
-		// LogMessage("DMR Slot %u, received network data header from %u to %s%u", m_slotNo, m_lc->getSrcId(), m_lc->getFLCO() == FLCO_GROUP ? "TG " : "", m_lc->getDstId());
+		// LogMessage("DMR Slot %u, received network data header from %u to %s%u", m_slotNo, m_lc.getSrcId(), m_lc.getFLCO() == FLCO_GROUP ? "TG " : "", m_lc.getDstId());
 		LogMessage("DMR Slot %u, received network data header", m_slotNo);
 	} else if (dataType == DT_VOICE_SYNC) {
 		if (m_state != RS_RELAYING_NETWORK_AUDIO)
@@ -535,10 +569,10 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		CDMRSync sync;
 		sync.addSync(data + 2U, DST_BS_AUDIO);
 
-		unsigned char fid = m_lc->getFID();
+		unsigned char fid = m_lc.getFID();
 		if (fid == FID_ETSI || fid == FID_DMRA)
 			m_errs += m_fec.regenerateDMR(data + 2U);
-		m_bits += 216U;
+		m_bits += 141U;
 
 		data[0U] = TAG_DATA;
 		data[1U] = 0x00U;
@@ -553,9 +587,7 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		m_n     = dmrData.getN();
 		::memcpy(m_lastFrame, data, DMR_FRAME_LENGTH_BYTES + 2U);
 
-#if defined(DUMP_DMR)
-		writeFile(data);
-#endif
+		writeRecording(data);
 	} else if (dataType == DT_VOICE) {
 		if (m_state != RS_RELAYING_NETWORK_AUDIO)
 			return;
@@ -570,10 +602,10 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 			insertSilence(dmrData.getSeqNo());
 		}
 
-		unsigned char fid = m_lc->getFID();
+		unsigned char fid = m_lc.getFID();
 		if (fid == FID_ETSI || fid == FID_DMRA)
 			m_errs += m_fec.regenerateDMR(data + 2U);
-		m_bits += 216U;
+		m_bits += 141U;
 
 		// Change the color code in the EMB
 		CEMB emb;
@@ -594,9 +626,7 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		m_n     = dmrData.getN();
 		::memcpy(m_lastFrame, data, DMR_FRAME_LENGTH_BYTES + 2U);
 
-#if defined(DUMP_DMR)
-		writeFile(data);
-#endif
+		writeRecording(data);
 	} else {
 		// Change the Color Code of the Slot Type
 		CSlotType slotType;
@@ -612,10 +642,7 @@ void CDMRSlot::writeNetwork(const CDMRData& dmrData)
 		data[1U] = 0x00U;
 
 		writeQueue(data);
-
-#if defined(DUMP_DMR)
-		writeFile(data);
-#endif
+		writeRecording(data);
 	}
 }
 
@@ -634,9 +661,6 @@ void CDMRSlot::clock(unsigned int ms)
 			else
 				LogMessage("DMR Slot %u, network watchdog has expired", m_slotNo);
 			writeEndOfTransmission();
-#if defined(DUMP_DMR)
-			closeFile();
-#endif
 		}
 	}
 
@@ -659,20 +683,70 @@ void CDMRSlot::clock(unsigned int ms)
 
 void CDMRSlot::writeQueue(const unsigned char *data)
 {
-	unsigned char len = DMR_FRAME_LENGTH_BYTES + 2U;
-	m_queue.addData(&len, 1U);
+	CDMRFrame frame;
+	frame.create();
+	frame.setLength(DMR_FRAME_LENGTH_BYTES + 2U);
 
 	// If the timeout has expired, replace the audio with idles to keep the slot busy
 	if (m_timeoutTimer.isRunning() && m_timeoutTimer.hasExpired())
-		m_queue.addData(m_idle, len);
+		::memcpy(frame.getData(), m_idle, DMR_FRAME_LENGTH_BYTES + 2U);
 	else
-		m_queue.addData(data, len);
+		::memcpy(frame.getData(), data, DMR_FRAME_LENGTH_BYTES + 2U);
+
+	CDMRFrame::countCopy(DCH_SLOT_QUEUE);
+
+	// The age of a queued frame is from when it was queued, not when it was received
+	frame.setTime();
+
+	if (!m_queue.add(frame)) {
+		LogWarning("DMR Slot %u, transmit queue full, frame dropped", m_slotNo);
+		return;
+	}
+
+	unsigned int depth = m_queue.depth();
+	if (depth > m_queueMaxDepth)
+		m_queueMaxDepth = depth;
+}
+
+void CDMRSlot::printStats()
+{
+	if (m_queueMaxDepth > 0U)
+		LogDebug("DMR Slot %u, transmit queue maximum depth %u frames, oldest frame %u ms, %u frames waited longer than %u ms", m_slotNo, m_queueMaxDepth, m_queueMaxAge, m_queueLate, DMR_SLOT_TIME);
+
+	m_queueMaxDepth = m_queue.depth();
+	m_queueMaxAge   = 0U;
+	m_queueLate     = 0U;
+
+	if (!m_latencies.empty()) {
+		std::vector<unsigned int>::iterator median = m_latencies.begin() + m_latencies.size() / 2U;
+		std::nth_element(m_latencies.begin(), median, m_latencies.end());
+
+		unsigned int min = *std::min_element(m_latencies.begin(), m_latencies.end());
+		unsigned int max = *std::max_element(m_latencies.begin(), m_latencies.end());
+
+		LogDebug("DMR Slot %u, modem to network latency over %u frames: minimum %u us, median %u us, maximum %u us", m_slotNo, (unsigned int)m_latencies.size(), min, *median, max);
+	}
+
+	m_latencies.clear();
 }
 
 void CDMRSlot::writeNetwork(const unsigned char* data, unsigned char dataType)
 {
-	assert(m_lc != NULL);
+	if (m_network == NULL)
+		return;
+
+	CDMRFrame frame;
+	frame.create();
+	frame.setLength(DMR_FRAME_LENGTH_BYTES + 2U);
+
+	::memcpy(frame.getData(), data, DMR_FRAME_LENGTH_BYTES + 2U);
+	CDMRFrame::countCopy(DCH_NETWORK);
 
+	writeNetwork(frame, dataType);
+}
+
+void CDMRSlot::writeNetwork(const CDMRFrame& frame, unsigned char dataType)
+{
 	if (m_network == NULL)
 		return;
 
@@ -683,20 +757,25 @@ void CDMRSlot::writeNetwork(const unsigned char* data, unsigned char dataType)
 	CDMRData dmrData;
 	dmrData.setSlotNo(m_slotNo);
 	dmrData.setDataType(dataType);
-	dmrData.setSrcId(m_lc->getSrcId());
-	dmrData.setDstId(m_lc->getDstId());
-	dmrData.setFLCO(m_lc->getFLCO());
+	dmrData.setSrcId(m_lc.getSrcId());
+	dmrData.setDstId(m_lc.getDstId());
+	dmrData.setFLCO(m_lc.getFLCO());
 	dmrData.setN(m_n);
 	dmrData.setSeqNo(m_seqNo);
 
 	m_seqNo++;
 
-	dmrData.setData(data + 2U);
+	dmrData.setData(frame);
 
 	m_network->write(dmrData);
+
+	// Only frames received from the modem have a time
+	unsigned int age = frame.getAge();
+	if (age > 0U && m_latencies.size() < LATENCY_SAMPLES)
+		m_latencies.push_back(age);
 }
 
-void CDMRSlot::init(unsigned int colorCode, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display)
+void CDMRSlot::init(unsigned int colorCode, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display, CDMRRecorder* recorder, bool debug)
 {
 	assert(modem != NULL);
 	assert(display != NULL);
@@ -705,6 +784,8 @@ void CDMRSlot::init(unsigned int colorCode, CModem* modem, CHomebrewDMRIPSC* net
 	m_modem     = modem;
 	m_network   = network;
 	m_display   = display;
+	m_recorder  = recorder;
+	m_debug     = debug;
 
 	m_idle = new unsigned char[DMR_FRAME_LENGTH_BYTES + 2U];
 
@@ -774,58 +855,56 @@ void CDMRSlot::setShortLC(unsigned int slotNo, unsigned int id, FLCO flco)
 			lc[1U] |= 0x09U;
 	}
 
-	lc[4U] = CCRC::crc8(lc, 4U);
+	// The rest of the Short LC only depends on these three bytes
+	unsigned int key = (lc[1U] << 16) | (lc[2U] << 8) | lc[3U];
+
+	SHORT_LC_ENTRY& entry = m_shortLCs[(lc[1U] ^ lc[2U] ^ lc[3U]) % SHORT_LC_CACHE_SIZE];
 
-	unsigned char sLC[9U];
+	if (!entry.m_valid || entry.m_key != key) {
+		lc[4U] = CCRC::crc8(lc, 4U);
 
-	CUtils::dump(1U, "Input Short LC", lc, 5U);
+		CShortLC shortLC;
+		shortLC.encode(lc, entry.m_sLC);
 
-	CShortLC shortLC;
-	shortLC.encode(lc, sLC);
+		entry.m_valid = true;
+		entry.m_key   = key;
 
-	CUtils::dump(1U, "Output Short LC", sLC, 9U);
+		if (m_debug) {
+			CUtils::dump(1U, "Input Short LC", lc, 5U);
+			CUtils::dump(1U, "Output Short LC", entry.m_sLC, 9U);
+		}
+	}
 
-	m_modem->writeDMRShortLC(sLC);
+	m_modem->writeDMRShortLC(entry.m_sLC);
 }
 
-bool CDMRSlot::openFile()
+void CDMRSlot::correctTerminator(unsigned char* data)
 {
-	if (m_fp != NULL)
-		return true;
-
-	time_t t;
-	::time(&t);
-
-	struct tm* tm = ::localtime(&t);
-
-	char name[100U];
-	::sprintf(name, "DMR_%u_%04d%02d%02d_%02d%02d%02d.ambe", m_slotNo, tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec);
+	assert(data != NULL);
 
-	m_fp = ::fopen(name, "wb");
-	if (m_fp == NULL)
-		return false;
-
-	::fwrite("DMR", 1U, 3U, m_fp);
-
-	return true;
+	// The LC is passed on as corrected, one that can't be decoded is passed on as received
+	CFullLC fullLC;
+	CLC lc;
+	if (fullLC.decode(data + 2U, DT_TERMINATOR_WITH_LC, lc))
+		fullLC.encode(lc, data + 2U, DT_TERMINATOR_WITH_LC);
 }
 
-bool CDMRSlot::writeFile(const unsigned char* data)
+void CDMRSlot::startRecording()
 {
-	if (m_fp == NULL)
-		return false;
-
-	::fwrite(data, 1U, DMR_FRAME_LENGTH_BYTES + 2U, m_fp);
+	if (m_recorder != NULL)
+		m_recorder->start(m_slotNo, m_lc.getSrcId(), m_lc.getDstId(), m_lc.getFLCO() == FLCO_GROUP);
+}
 
-	return true;
+void CDMRSlot::writeRecording(const unsigned char* data)
+{
+	if (m_recorder != NULL)
+		m_recorder->write(m_slotNo, data);
 }
 
-void CDMRSlot::closeFile()
+void CDMRSlot::endRecording()
 {
-	if (m_fp != NULL) {
-		::fclose(m_fp);
-		m_fp = NULL;
-	}
+	if (m_recorder != NULL)
+		m_recorder->end(m_slotNo);
 }
 
 void CDMRSlot::insertSilence(unsigned char newSeqNo)
@@ -20,11 +20,12 @@
 #define	DMRSlot_H
 
 #include "HomebrewDMRIPSC.h"
+#include "DMRRecorder.h"
 #include "StopWatch.h"
 #include "EmbeddedLC.h"
-#include "RingBuffer.h"
 #include "AMBEFEC.h"
 #include "DMRSlot.h"
+#include "DMRFrame.h"
 #include "DMRData.h"
 #include "Display.h"
 #include "Defines.h"
@@ -32,12 +33,14 @@
 #include "Modem.h"
 #include "LC.h"
 
+#include <vector>
+
 class CDMRSlot {
 public:
 	CDMRSlot(unsigned int slotNo, unsigned int timeout);
 	~CDMRSlot();
 
-	void writeModem(unsigned char* data);
+	void writeModem(CDMRFrame& frame);
 
 	unsigned int readModem(unsigned char* data);
 
@@ -45,14 +48,20 @@ public:
 
 	void clock(unsigned int ms);
 
-	static void init(unsigned int colorCode, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display);
+	void printStats();
+
+	static void init(unsigned int colorCode, CModem* modem, CHomebrewDMRIPSC* network, IDisplay* display, CDMRRecorder* recorder, bool debug);
 
 private:
 	unsigned int               m_slotNo;
-	CRingBuffer<unsigned char> m_queue;
+	CDMRFrameQueue             m_queue;
+	unsigned int               m_queueMaxDepth;
+	unsigned int               m_queueMaxAge;
+	unsigned int               m_queueLate;
+	std::vector<unsigned int>  m_latencies;
 	RPT_STATE                  m_state;
 	CEmbeddedLC                m_embeddedLC;
-	CLC*                       m_lc;
+	CLC                        m_lc;
 	unsigned char              m_seqNo;
 	unsigned char              m_n;
 	unsigned char*             m_lastFrame;
@@ -65,12 +74,12 @@ private:
 	CAMBEFEC                   m_fec;
 	unsigned int               m_bits;
 	unsigned int               m_errs;
-	FILE*                      m_fp;
 
 	static unsigned int        m_colorCode;
 	static CModem*             m_modem;
 	static CHomebrewDMRIPSC*   m_network;
 	static IDisplay*           m_display;
+	static CDMRRecorder*       m_recorder;
 
 	static unsigned char*      m_idle;
 
@@ -79,14 +88,28 @@ private:
 	static FLCO                m_flco2;
 	static unsigned char       m_id2;
 
+	static bool                m_debug;
+
+	// Encoded Short LCs, keyed on the flags and the two ID hashes
+	struct SHORT_LC_ENTRY {
+		bool          m_valid;
+		unsigned int  m_key;
+		unsigned char m_sLC[9U];
+	};
+
+	static SHORT_LC_ENTRY      m_shortLCs[];
+
 	void writeQueue(const unsigned char* data);
 	void writeNetwork(const unsigned char* data, unsigned char dataType);
+	void writeNetwork(const CDMRFrame& frame, unsigned char dataType);
 
 	void writeEndOfTransmission();
 
-	bool openFile();
-	bool writeFile(const unsigned char* data);
-	void closeFile();
+	void correctTerminator(unsigned char* data);
+
+	void startRecording();
+	void writeRecording(const unsigned char* data);
+	void endRecording();
 
 	void insertSilence(unsigned char seqNo);
 
@@ -19,7 +19,6 @@
 #include "EmbeddedLC.h"
 
 #include "Hamming.h"
-#include "Utils.h"
 #include "CRC.h"
 #include "Log.h"
 
@@ -27,127 +26,165 @@
 #include <cassert>
 #include <cstring>
 
+// The 128 bits of an embedded LC are 8 rows of 16 bits sent a column at a
+// time, so each byte of m_rawLC is one column with the first row in its top
+// bit. The rows are held packed, the first column in the top bit.
+
+// Transpose an 8x8 bit matrix held one row per byte, the first row in the most significant byte
+static unsigned long long transpose8(unsigned long long x)
+{
+	unsigned long long t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
+
+static void columnsToRows(const unsigned int* raw, unsigned int* rows)
+{
+	unsigned long long hi = transpose8((((unsigned long long)raw[0U]) << 32) | raw[1U]);
+	unsigned long long lo = transpose8((((unsigned long long)raw[2U]) << 32) | raw[3U]);
+
+	for (unsigned int r = 0U; r < 8U; r++) {
+		unsigned int shift = 56U - r * 8U;
+		rows[r] = (((unsigned int)(hi >> shift) & 0xFFU) << 8) | ((unsigned int)(lo >> shift) & 0xFFU);
+	}
+}
+
+static void rowsToColumns(const unsigned int* rows, unsigned int* raw)
+{
+	unsigned long long hi = 0ULL;
+	unsigned long long lo = 0ULL;
+
+	for (unsigned int r = 0U; r < 8U; r++) {
+		hi = (hi << 8) | ((rows[r] >> 8) & 0xFFU);
+		lo = (lo << 8) | ((rows[r] >> 0) & 0xFFU);
+	}
+
+	hi = transpose8(hi);
+	lo = transpose8(lo);
+
+	raw[0U] = (unsigned int)(hi >> 32);
+	raw[1U] = (unsigned int)(hi >> 0);
+	raw[2U] = (unsigned int)(lo >> 32);
+	raw[3U] = (unsigned int)(lo >> 0);
+}
+
+// The 72 LC bits occupy the first 11 columns of the first two rows and the
+// first 10 columns of the next five
+static unsigned int lcBits(unsigned int row)
+{
+	return row < 2U ? 11U : 10U;
+}
+
 CEmbeddedLC::CEmbeddedLC() :
-m_rawLC(NULL),
+m_rawLC(),
 m_state(LCS_NONE)
 {
-	m_rawLC = new bool[128U];
 }
 
 CEmbeddedLC::~CEmbeddedLC()
 {
-	delete[] m_rawLC;
 }
 
 // Add LC data (which may consist of 4 blocks) to the data store
-CLC* CEmbeddedLC::addData(const unsigned char* data, unsigned char lcss)
+bool CEmbeddedLC::addData(const unsigned char* data, unsigned char lcss, CLC& lc)
 {
 	assert(data != NULL);
 
-	bool rawData[40U];
-	CUtils::byteToBitsBE(data[14U], rawData + 0U);
-	CUtils::byteToBitsBE(data[15U], rawData + 8U);
-	CUtils::byteToBitsBE(data[16U], rawData + 16U);
-	CUtils::byteToBitsBE(data[17U], rawData + 24U);
-	CUtils::byteToBitsBE(data[18U], rawData + 32U);
+	// The 32 bits of embedded signalling between the EMB halves
+	unsigned int rawData = ((data[14U] & 0x0FU) << 28) | (data[15U] << 20) | (data[16U] << 12) | (data[17U] << 4) | (data[18U] >> 4);
 
 	// Is this the first block of a 4 block embedded LC ?
 	if (lcss == 1U) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_rawLC[a] = rawData[a + 4U];
+		m_rawLC[0U] = rawData;
 
 		// Show we are ready for the next LC block
 		m_state = LCS_FIRST;
-		return NULL;
+		return false;
 	}
 
 	// Is this the 2nd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_FIRST) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_rawLC[a + 32U] = rawData[a + 4U];
+		m_rawLC[1U] = rawData;
 
 		// Show we are ready for the next LC block
 		m_state = LCS_SECOND;
-		return NULL;
+		return false;
 	}
 
 	// Is this the 3rd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_SECOND) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_rawLC[a + 64U] = rawData[a + 4U];
+		m_rawLC[2U] = rawData;
 
 		// Show we are ready for the final LC block
 		m_state = LCS_THIRD;
-		return NULL;
+		return false;
 	}
 
 	// Is this the final block of a 4 block embedded LC ?
 	if (lcss == 2U && m_state == LCS_THIRD)	{
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_rawLC[a + 96U] = rawData[a + 4U];
+		m_rawLC[3U] = rawData;
 
 		// Process the complete data block
-		return processMultiBlockEmbeddedLC();
+		return processMultiBlockEmbeddedLC(lc);
 	}
 
 	// Is this a single block embedded LC
 	if (lcss == 0U) {
-		processSingleBlockEmbeddedLC(rawData + 4U);
-		return NULL;
+		processSingleBlockEmbeddedLC(rawData);
+		return false;
 	}
 
-	return NULL;
+	return false;
 }
 
 void CEmbeddedLC::setData(const CLC& lc)
 {
-	bool lcData[72U];
+	unsigned char lcData[9U];
+	::memset(lcData, 0x00U, 9U);
 	lc.getData(lcData);
-	
+
 	unsigned int crc;
 	CCRC::encodeFiveBit(lcData, crc);
 
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	data[106U] = (crc & 0x01U) == 0x01U;
-	data[90U]  = (crc & 0x02U) == 0x02U;
-	data[74U]  = (crc & 0x04U) == 0x04U;
-	data[58U]  = (crc & 0x08U) == 0x08U;
-	data[42U]  = (crc & 0x10U) == 0x10U;
-
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		data[a] = lcData[b];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		data[a] = lcData[b];
+	unsigned int rows[8U];
+
+	unsigned int acc = 0U;
+	unsigned int count = 0U;
+	unsigned int n = 0U;
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int bits = lcBits(r);
+
+		while (count < bits) {
+			acc = (acc << 8) | lcData[n++];
+			count += 8U;
+		}
+
+		count -= bits;
+		rows[r] = ((acc >> count) & ((1U << bits) - 1U)) << (16U - bits);
+	}
+
+	// The CRC goes in column 10 of rows 2 to 6, most significant bit first
+	for (unsigned int r = 2U; r < 7U; r++)
+		rows[r] |= ((crc >> (6U - r)) & 0x01U) << 5;
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U)
-		CHamming::encode16114(data + a);
+	for (unsigned int r = 0U; r < 7U; r++)
+		rows[r] = CHamming::encode16114(rows[r]);
 
 	// Add the parity bits for each column
-	for (unsigned int a = 0U; a < 16U; a++)
-		data[a + 112U] = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U];
+	rows[7U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U];
 
 	// The data is packed downwards in columns
-	b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		m_rawLC[a] = data[b];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
-	}
+	rowsToColumns(rows, m_rawLC);
 }
 
 unsigned int CEmbeddedLC::getData(unsigned char* data, unsigned int n) const
@@ -155,22 +192,13 @@ unsigned int CEmbeddedLC::getData(unsigned char* data, unsigned int n) const
 	assert(data != NULL);
 
 	if (n < 4U) {
-		bool bits[40U];
-		::memset(bits, 0x00U, 40U * sizeof(bool));
-		::memcpy(bits + 4U, m_rawLC + n * 32U, 32U * sizeof(bool));
-
-		unsigned char bytes[5U];
-		CUtils::bitsToByteBE(bits + 0U,  bytes[0U]);
-		CUtils::bitsToByteBE(bits + 8U,  bytes[1U]);
-		CUtils::bitsToByteBE(bits + 16U, bytes[2U]);
-		CUtils::bitsToByteBE(bits + 24U, bytes[3U]);
-		CUtils::bitsToByteBE(bits + 32U, bytes[4U]);
-
-		data[14U] = (data[14U] & 0xF0U) | (bytes[0U] & 0x0FU);
-		data[15U] = bytes[1U];
-		data[16U] = bytes[2U];
-		data[17U] = bytes[3U];
-		data[18U] = (data[18U] & 0x0FU) | (bytes[4U] & 0xF0U);
+		unsigned int rawData = m_rawLC[n];
+
+		data[14U] = (data[14U] & 0xF0U) | (rawData >> 28);
+		data[15U] = rawData >> 20;
+		data[16U] = rawData >> 12;
+		data[17U] = rawData >> 4;
+		data[18U] = (data[18U] & 0x0FU) | ((rawData << 4) & 0xF0U);
 	} else {
 		data[14U] &= 0xF0U;
 		data[15U]  = 0x00U;
@@ -193,74 +221,62 @@ unsigned int CEmbeddedLC::getData(unsigned char* data, unsigned int n) const
 }
 
 // Unpack and error check an embedded LC
-CLC* CEmbeddedLC::processMultiBlockEmbeddedLC()
+bool CEmbeddedLC::processMultiBlockEmbeddedLC(CLC& lc)
 {
 	// The data is unpacked downwards in columns
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		data[b] = m_rawLC[a];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
-	}
+	unsigned int rows[8U];
+	columnsToRows(m_rawLC, rows);
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U) {
-		if (!CHamming::decode16114(data + a)) {
+	for (unsigned int r = 0U; r < 7U; r++) {
+		if (!CHamming::decode16114(rows[r])) {
 			::LogDebug("Hamming decode of a row of the Embedded LC failed");
-			return NULL;
+			return false;
 		}
 	}
 
 	// Check the parity bits
-	for (unsigned int a = 0U; a < 16U; a++) {
-		bool parity = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U] ^ data[a + 112U];
-		if (parity) {
-			::LogDebug("Parity check of a column of the Embedded LC failed");
-			return NULL;
-		}
+	if ((rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U] ^ rows[7U]) != 0U) {
+		::LogDebug("Parity check of a column of the Embedded LC failed");
+		return false;
 	}
 
 	// We have passed the Hamming check so extract the actual payload
-	bool lcData[72U];
-	b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		lcData[b] = data[a];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		lcData[b] = data[a];
+	unsigned char lcData[9U];
+
+	unsigned int acc = 0U;
+	unsigned int count = 0U;
+	unsigned int n = 0U;
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int bits = lcBits(r);
+
+		acc = (acc << bits) | (rows[r] >> (16U - bits));
+		count += bits;
+
+		while (count >= 8U) {
+			count -= 8U;
+			lcData[n++] = acc >> count;
+		}
+	}
 
 	// Extract the 5 bit CRC
 	unsigned int crc = 0U;
-	if (data[42])  crc += 16U;
-	if (data[58])  crc += 8U;
-	if (data[74])  crc += 4U;
-	if (data[90])  crc += 2U;
-	if (data[106]) crc += 1U;
+	for (unsigned int r = 2U; r < 7U; r++)
+		crc = (crc << 1) | ((rows[r] >> 5) & 0x01U);
 
 	// Now CRC check this
 	if (!CCRC::checkFiveBit(lcData, crc)) {
 		::LogDebug("Checksum of the Embedded LC failed");
-		return NULL;
+		return false;
 	}
 
-	return new CLC(lcData);
+	lc = CLC(lcData);
+
+	return true;
 }
 
 // Deal with a single block embedded LC
-void CEmbeddedLC::processSingleBlockEmbeddedLC(const bool* data)
+void CEmbeddedLC::processSingleBlockEmbeddedLC(unsigned int data)
 {
 	// Nothing interesting, or just NULL (I think)
 }
@@ -34,17 +34,18 @@ public:
 	CEmbeddedLC();
 	~CEmbeddedLC();
 
-	CLC* addData(const unsigned char* data, unsigned char lcss);
+	// Returns true and fills in lc when the final block of a valid LC arrives
+	bool addData(const unsigned char* data, unsigned char lcss, CLC& lc);
 
 	void setData(const CLC& lc);
 	unsigned int getData(unsigned char* data, unsigned int n) const;
 
 private:
-	bool*    m_rawLC;
-	LC_STATE m_state;
+	unsigned int m_rawLC[4U];
+	LC_STATE     m_state;
 
-	CLC* processMultiBlockEmbeddedLC();
-	void processSingleBlockEmbeddedLC(const bool* data);
+	bool processMultiBlockEmbeddedLC(CLC& lc);
+	void processSingleBlockEmbeddedLC(unsigned int data);
 };
 
 #endif
@@ -0,0 +1,129 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Runs a corpus of random LCs through CEmbeddedLC::setData() and getData(),
+// then feeds the four fragments of each back through addData() with up to
+// three bit errors, and now and then the wrong LCSS, so that the reassembly
+// sees both good and bad LCs and out of order fragments. The hashes of the
+// bursts and of the reassembled LCs are compared with those recorded from the
+// bool array implementation.
+
+#include "EmbeddedLC.h"
+#include "LC.h"
+#include "FNV.h"
+
+#include <cstdio>
+
+const unsigned int CORPUS_LCS = 300000U;
+
+const unsigned int ENCODE_CHECKSUM = 0xB739CA4DU;
+const unsigned int DECODE_CHECKSUM = 0x2C462EDEU;
+
+static unsigned int m_random = 0x12345678U;
+
+// xorshift32, the same corpus every run
+static unsigned int nextRandom()
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+
+	return m_random;
+}
+
+static bool addData(CEmbeddedLC& embeddedLC, const unsigned char* data, unsigned char lcss, CLC& lc)
+{
+	return embeddedLC.addData(data, lcss, lc);
+}
+
+static bool check(const char* name, unsigned int checksum, unsigned int expected)
+{
+	if (checksum != expected) {
+		::fprintf(stdout, "%-8s FAILED, checksum 0x%08X, expected 0x%08X\n", name, checksum, expected);
+		return false;
+	}
+
+	::fprintf(stdout, "%-8s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	CEmbeddedLC encoder;
+	CEmbeddedLC decoder;
+
+	CFNV encodeHash;
+	CFNV decodeHash;
+
+	for (unsigned int n = 0U; n < CORPUS_LCS; n++) {
+		unsigned char bytes[9U];
+		for (unsigned int i = 0U; i < 9U; i++)
+			bytes[i] = nextRandom();
+
+		encoder.setData(CLC(bytes));
+
+		// The fifth burst has no embedded LC
+		unsigned char bursts[5U][33U];
+		unsigned char lcss[5U];
+		for (unsigned int i = 0U; i < 5U; i++) {
+			for (unsigned int j = 0U; j < 33U; j++)
+				bursts[i][j] = nextRandom();
+
+			lcss[i] = encoder.getData(bursts[i], i);
+
+			encodeHash.add(bursts[i], 33U);
+			encodeHash.add(lcss[i], 1U);
+		}
+
+		// The embedded signalling is in the forty bits from byte 14
+		unsigned int errors = nextRandom() % 4U;
+		for (unsigned int i = 0U; i < errors; i++) {
+			unsigned int pos = nextRandom() % 160U;
+			bursts[pos / 40U][14U + (pos % 40U) / 8U] ^= 0x80U >> (pos % 8U);
+		}
+
+		for (unsigned int i = 0U; i < 4U; i++) {
+			if ((nextRandom() % 16U) == 0U)
+				lcss[i] = nextRandom() % 4U;
+
+			CLC lc;
+			bool ret = addData(decoder, bursts[i], lcss[i], lc);
+
+			decodeHash.add(ret ? 1U : 0U, 1U);
+			if (ret) {
+				lc.getData(bytes);
+				decodeHash.add(bytes, 9U);
+			}
+		}
+	}
+
+	unsigned int failed = 0U;
+
+	if (!check("encode", encodeHash.get(), ENCODE_CHECKSUM))
+		failed++;
+	if (!check("decode", decodeHash.get(), DECODE_CHECKSUM))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u embedded LC routines differ from the bool array implementation\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "EventLoop.h"
+#include "Log.h"
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+const unsigned int MAX_EVENTS = 8U;
+
+#if defined(_WIN32) || defined(_WIN64)
+
+CEventLoop::CEventLoop() :
+m_tick(0U),
+m_ioWakeups(0U),
+m_tickWakeups(0U),
+m_timeouts(0U)
+{
+}
+
+CEventLoop::~CEventLoop()
+{
+}
+
+bool CEventLoop::open()
+{
+	return true;
+}
+
+bool CEventLoop::addFd(int)
+{
+	return true;
+}
+
+void CEventLoop::setTick(unsigned int ms)
+{
+	m_tick = ms;
+}
+
+void CEventLoop::wait(unsigned int)
+{
+	::Sleep(5UL);		// 5ms
+
+	m_timeouts++;
+}
+
+void CEventLoop::close()
+{
+}
+
+#else
+
+CEventLoop::CEventLoop() :
+m_epollFd(-1),
+m_timerFd(-1),
+m_tick(0U),
+m_ioWakeups(0U),
+m_tickWakeups(0U),
+m_timeouts(0U)
+{
+}
+
+CEventLoop::~CEventLoop()
+{
+}
+
+bool CEventLoop::open()
+{
+	m_epollFd = ::epoll_create1(0);
+	if (m_epollFd < 0) {
+		LogError("Cannot create the epoll instance, errno=%d", errno);
+		return false;
+	}
+
+	m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+	if (m_timerFd < 0) {
+		LogError("Cannot create the tick timer, errno=%d", errno);
+		::close(m_epollFd);
+		m_epollFd = -1;
+		return false;
+	}
+
+	bool ret = addFd(m_timerFd);
+	if (!ret) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool CEventLoop::addFd(int fd)
+{
+	assert(m_epollFd != -1);
+	assert(fd >= 0);
+
+	epoll_event event;
+	event.events  = EPOLLIN;
+	event.data.fd = fd;
+
+	if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+		LogError("Cannot add fd %d to the event loop, errno=%d", fd, errno);
+		return false;
+	}
+
+	return true;
+}
+
+void CEventLoop::setTick(unsigned int ms)
+{
+	assert(m_timerFd != -1);
+
+	if (ms == m_tick)
+		return;
+
+	m_tick = ms;
+
+	itimerspec spec;
+	spec.it_interval.tv_sec  = ms / 1000U;
+	spec.it_interval.tv_nsec = (ms % 1000U) * 1000000L;
+	spec.it_value = spec.it_interval;
+
+	if (::timerfd_settime(m_timerFd, 0, &spec, NULL) < 0)
+		LogError("Cannot set the tick timer, errno=%d", errno);
+}
+
+void CEventLoop::wait(unsigned int timeout)
+{
+	assert(m_epollFd != -1);
+
+	epoll_event events[MAX_EVENTS];
+
+	int n = ::epoll_wait(m_epollFd, events, MAX_EVENTS, int(timeout));
+	if (n < 0) {
+		if (errno != EINTR)
+			LogError("Error from epoll_wait(), errno=%d", errno);
+		return;
+	}
+
+	if (n == 0) {
+		m_timeouts++;
+		return;
+	}
+
+	bool io = false;
+	for (int i = 0; i < n; i++) {
+		if (events[i].data.fd == m_timerFd) {
+			// Consume the expiry count so the timer can fire again
+			uint64_t expiries;
+			ssize_t len = ::read(m_timerFd, &expiries, sizeof(uint64_t));
+			if (len == ssize_t(sizeof(uint64_t)))
+				m_tickWakeups++;
+		} else if ((events[i].events & (EPOLLHUP | EPOLLERR)) != 0U) {
+			// A level triggered hang up is reported on every call, so stop watching it and rely on the tick
+			LogError("fd %d has hung up or failed, it is no longer watched by the event loop", events[i].data.fd);
+			::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, events[i].data.fd, NULL);
+			io = true;
+		} else {
+			io = true;
+		}
+	}
+
+	if (io)
+		m_ioWakeups++;
+}
+
+void CEventLoop::close()
+{
+	if (m_timerFd != -1) {
+		::close(m_timerFd);
+		m_timerFd = -1;
+	}
+
+	if (m_epollFd != -1) {
+		::close(m_epollFd);
+		m_epollFd = -1;
+	}
+}
+
+#endif
+
+unsigned int CEventLoop::getIOWakeups() const
+{
+	return m_ioWakeups;
+}
+
+unsigned int CEventLoop::getTickWakeups() const
+{
+	return m_tickWakeups;
+}
+
+unsigned int CEventLoop::getTimeouts() const
+{
+	return m_timeouts;
+}
+
+void CEventLoop::resetStats()
+{
+	m_ioWakeups   = 0U;
+	m_tickWakeups = 0U;
+	m_timeouts    = 0U;
+}
@@ -0,0 +1,57 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(EVENTLOOP_H)
+#define	EVENTLOOP_H
+
+// Waits for the modem, the network or the tick timer to become ready. On Linux
+// this uses epoll with a timerfd for the tick, elsewhere it falls back to a
+// fixed sleep of one tick.
+class CEventLoop {
+public:
+	CEventLoop();
+	~CEventLoop();
+
+	bool open();
+
+	bool addFd(int fd);
+
+	// A non-zero tick arms a periodic timer, zero disarms it
+	void setTick(unsigned int ms);
+
+	void wait(unsigned int timeout);
+
+	unsigned int getIOWakeups() const;
+	unsigned int getTickWakeups() const;
+	unsigned int getTimeouts() const;
+	void resetStats();
+
+	void close();
+
+private:
+#if !defined(_WIN32) && !defined(_WIN64)
+	int          m_epollFd;
+	int          m_timerFd;
+#endif
+	unsigned int m_tick;
+	unsigned int m_ioWakeups;
+	unsigned int m_tickWakeups;
+	unsigned int m_timeouts;
+};
+
+#endif
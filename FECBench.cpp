@@ -0,0 +1,155 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Measures the throughput in frames a second of the FEC routines that run on
+// every DMR burst. Built with 'make bench', it isn't part of the normal build.
+
+#include "BPTC19696.h"
+#include "EmbeddedLC.h"
+#include "LC.h"
+
+#include <chrono>
+#include <vector>
+
+#include <cstdio>
+#include <cstring>
+
+const unsigned int BENCH_FRAMES = 2000000U;
+
+// The frames are cycled through so that they stay in the cache
+const unsigned int CORPUS_FRAMES = 1024U;
+
+static unsigned int m_random = 0x12345678U;
+
+static unsigned int nextRandom()
+{
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+
+	return m_random;
+}
+
+static unsigned char m_payloads[CORPUS_FRAMES][12U];
+static unsigned char m_bursts[CORPUS_FRAMES][33U];
+
+// Stops the compiler from throwing the results away
+static volatile unsigned char m_sink = 0U;
+
+static void report(const char* name, std::chrono::steady_clock::time_point start)
+{
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	::fprintf(stdout, "%-24s %10.0f frames/s, %6.1f ns/frame\n", name, double(BENCH_FRAMES) / elapsed.count(), elapsed.count() * 1.0E9 / double(BENCH_FRAMES));
+}
+
+static void benchBPTC()
+{
+	CBPTC19696 bptc;
+
+	for (unsigned int n = 0U; n < CORPUS_FRAMES; n++) {
+		for (unsigned int i = 0U; i < 12U; i++)
+			m_payloads[n][i] = nextRandom();
+		for (unsigned int i = 0U; i < 33U; i++)
+			m_bursts[n][i] = nextRandom();
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int n = 0U; n < BENCH_FRAMES; n++) {
+		unsigned int i = n % CORPUS_FRAMES;
+		bptc.encode(m_payloads[i], m_bursts[i]);
+		m_sink ^= m_bursts[i][0U];
+	}
+
+	report("BPTC (196,96) encode", start);
+
+	// A single bit error in each burst
+	for (unsigned int n = 0U; n < CORPUS_FRAMES; n++) {
+		unsigned int pos = nextRandom() % 264U;
+		m_bursts[n][pos / 8U] ^= 0x80U >> (pos % 8U);
+	}
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int n = 0U; n < BENCH_FRAMES; n++) {
+		unsigned int i = n % CORPUS_FRAMES;
+		unsigned char payload[12U];
+		bptc.decode(m_bursts[i], payload);
+		m_sink ^= payload[0U];
+	}
+
+	report("BPTC (196,96) decode", start);
+}
+
+// A frame here is one LC, spread over the four bursts of a voice superframe
+static void benchEmbeddedLC()
+{
+	CEmbeddedLC encoder;
+	CEmbeddedLC decoder;
+
+	std::vector<CLC> lcs;
+	for (unsigned int n = 0U; n < CORPUS_FRAMES; n++) {
+		unsigned char bytes[9U];
+		for (unsigned int i = 0U; i < 9U; i++)
+			bytes[i] = nextRandom();
+
+		lcs.push_back(CLC(bytes));
+	}
+
+	unsigned char bursts[4U][33U];
+	unsigned char lcss[4U];
+	::memset(bursts, 0x00U, 4U * 33U);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int n = 0U; n < BENCH_FRAMES; n++) {
+		encoder.setData(lcs[n % CORPUS_FRAMES]);
+
+		for (unsigned int i = 0U; i < 4U; i++)
+			lcss[i] = encoder.getData(bursts[i], i);
+
+		m_sink ^= bursts[3U][14U];
+	}
+
+	report("Embedded LC encode", start);
+
+	// The bursts of the last LC, with a single bit error in one of them
+	unsigned int pos = nextRandom() % 160U;
+	bursts[pos / 40U][14U + (pos % 40U) / 8U] ^= 0x80U >> (pos % 8U);
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int n = 0U; n < BENCH_FRAMES; n++) {
+		CLC lc;
+		for (unsigned int i = 0U; i < 4U; i++) {
+			if (decoder.addData(bursts[i], lcss[i], lc))
+				m_sink ^= lc.getSrcId();
+		}
+	}
+
+	report("Embedded LC decode", start);
+}
+
+int main(int argc, char** argv)
+{
+	benchBPTC();
+	benchEmbeddedLC();
+
+	return 0;
+}
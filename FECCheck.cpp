@@ -0,0 +1,121 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Checks the FEC tables built at start-up against the literal tables that they
+// replaced. The lengths and FNV-1a hashes below were taken from the literals.
+// FECCheckSmall is the same program built with GOLAY_SMALL_TABLES, there the
+// Golay (23,12) and (24,12) encoders are checked against the full tables.
+
+#include "FECTables.h"
+#include "Golay24128.h"
+
+#include <cstdio>
+
+struct FEC_CHECKSUM {
+	const char*  m_name;
+	unsigned int m_length;
+	unsigned int m_checksum;
+};
+
+const FEC_CHECKSUM TABLES[] = {
+	{"DECODING_TABLE_23127",       2048U, 0xC24523FDU},
+	{"SYNDROME_TABLE_23127_BYTE1",  256U, 0x76DBF205U},
+	{"SYNDROME_TABLE_23127_BYTE2",  128U, 0xB26B1765U},
+	{"ENCODING_TABLE_2087",         256U, 0x28B120C5U},
+	{"DECODING_TABLE_1987",        2048U, 0xB67C5636U},
+	{"SYNDROME_TABLE_1987_BYTE1",   256U, 0x76DBF205U},
+	{"SYNDROME_TABLE_1987_BYTE2",     8U, 0x67496189U},
+	{"ENCODING_TABLE_1676",         128U, 0xDC1441E5U},
+	{"DECODING_TABLE_1576",         256U, 0x18436905U},
+	{"EXP_TABLE",                   512U, 0x2D69430CU},
+	{"LOG_TABLE",                   256U, 0x7A55B7CEU},
+	{"MULT_TABLE_64",               256U, 0xF896EB85U},
+	{"MULT_TABLE_56",               256U, 0xF5A09445U},
+	{"MULT_TABLE_14",               256U, 0xD9886345U},
+	{"MULT_TABLE_2",                256U, 0xF221A2C5U},
+	{"MULT_TABLE_4",                256U, 0x47C1AAC5U},
+	{"MULT_TABLE_8",                256U, 0x1B4425C5U},
+	{"PRNG_TABLE",                 4096U, 0x6CAC6DC5U}};
+
+const unsigned int ENCODING_TABLE_23127_CHECKSUM = 0xABC44D45U;
+const unsigned int ENCODING_TABLE_24128_CHECKSUM = 0xC2D64645U;
+
+// Hashed in the same way as CFECTables::getChecksum()
+static unsigned int getEncoderChecksum(unsigned int (*encode)(unsigned int))
+{
+	unsigned int checksum = 0x811C9DC5U;
+
+	for (unsigned int i = 0U; i < 4096U; i++) {
+		unsigned int value = encode(i);
+
+		for (unsigned int k = 0U; k < 4U; k++) {
+			checksum ^= (value >> (k * 8U)) & 0xFFU;
+			checksum *= 0x01000193U;
+		}
+	}
+
+	return checksum;
+}
+
+// The literal table held the codewords one bit to the left, ready for the parity bit
+static unsigned int encode23127(unsigned int data)
+{
+	return CGolay24128::encode23127(data) << 1;
+}
+
+static bool check(const char* name, unsigned int length, unsigned int checksum, unsigned int expectedLength, unsigned int expectedChecksum)
+{
+	if (length != expectedLength || checksum != expectedChecksum) {
+		::fprintf(stdout, "%-28s FAILED, %u entries with checksum 0x%08X, expected %u with 0x%08X\n", name, length, checksum, expectedLength, expectedChecksum);
+		return false;
+	}
+
+	::fprintf(stdout, "%-28s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failed = 0U;
+
+	for (unsigned int i = 0U; i < sizeof(TABLES) / sizeof(FEC_CHECKSUM); i++) {
+		unsigned int length, checksum;
+		if (!CFECTables::getChecksum(TABLES[i].m_name, length, checksum)) {
+			::fprintf(stdout, "%-28s FAILED, the table has not been registered\n", TABLES[i].m_name);
+			failed++;
+			continue;
+		}
+
+		if (!check(TABLES[i].m_name, length, checksum, TABLES[i].m_length, TABLES[i].m_checksum))
+			failed++;
+	}
+
+	if (!check("ENCODING_TABLE_23127", 4096U, getEncoderChecksum(encode23127), 4096U, ENCODING_TABLE_23127_CHECKSUM))
+		failed++;
+
+	if (!check("ENCODING_TABLE_24128", 4096U, getEncoderChecksum(CGolay24128::encode24128), 4096U, ENCODING_TABLE_24128_CHECKSUM))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u FEC tables differ from the literal tables\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "FECTables.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+const unsigned int MAX_FEC_TABLES = 20U;
+
+// Filled in during static initialisation, so plain data that needs no constructor
+CFECTables::FEC_TABLE CFECTables::m_tables[MAX_FEC_TABLES];
+unsigned int CFECTables::m_count = 0U;
+
+unsigned int CFECTables::getRemainder(unsigned int pattern, unsigned int n, unsigned int generator, unsigned int degree)
+{
+	assert(degree > 0U);
+	assert(n > degree);
+
+	for (unsigned int i = n - 1U; i >= degree; i--) {
+		if ((pattern & (1U << i)) != 0U)
+			pattern ^= generator << (i - degree);
+	}
+
+	return pattern;
+}
+
+unsigned int CFECTables::getCodeword(unsigned int data, unsigned int n, unsigned int generator, unsigned int degree)
+{
+	unsigned int pattern = data << degree;
+
+	return pattern | getRemainder(pattern, n, generator, degree);
+}
+
+unsigned int CFECTables::getParity(unsigned int value)
+{
+	unsigned int parity = 0U;
+
+	for (; value != 0U; value >>= 1)
+		parity ^= value & 0x01U;
+
+	return parity;
+}
+
+void CFECTables::generateDecodingTable(unsigned int* table, unsigned int n, unsigned int generator, unsigned int degree, unsigned int maxWeight)
+{
+	assert(table != NULL);
+
+	for (unsigned int i = 0U; i < (1U << degree); i++)
+		table[i] = 0U;
+
+	for (unsigned int weight = 1U; weight <= maxWeight; weight++)
+		addPatterns(table, 0U, 0U, weight, n, generator, degree);
+}
+
+void CFECTables::addPatterns(unsigned int* table, unsigned int pattern, unsigned int first, unsigned int weight, unsigned int n, unsigned int generator, unsigned int degree)
+{
+	for (unsigned int i = first; i < n; i++) {
+		unsigned int next = pattern | (1U << i);
+
+		if (weight > 1U) {
+			addPatterns(table, next, i + 1U, weight - 1U, n, generator, degree);
+		} else {
+			// Only the zero pattern has a zero syndrome
+			unsigned int syndrome = getRemainder(next, n, generator, degree);
+			if (syndrome != 0U && table[syndrome] == 0U)
+				table[syndrome] = next;
+		}
+	}
+}
+
+void CFECTables::addTable(const char* name, const unsigned int* table, unsigned int length)
+{
+	addTable(name, (const unsigned char*)table, sizeof(unsigned int), length);
+}
+
+void CFECTables::addTable(const char* name, const unsigned char* table, unsigned int length)
+{
+	addTable(name, table, 1U, length);
+}
+
+void CFECTables::addTable(const char* name, const unsigned char* data, unsigned int size, unsigned int length)
+{
+	assert(name != NULL);
+	assert(data != NULL);
+	assert(m_count < MAX_FEC_TABLES);
+
+	m_tables[m_count].m_name   = name;
+	m_tables[m_count].m_data   = data;
+	m_tables[m_count].m_size   = size;
+	m_tables[m_count].m_length = length;
+	m_count++;
+}
+
+bool CFECTables::getChecksum(const char* name, unsigned int& length, unsigned int& checksum)
+{
+	assert(name != NULL);
+
+	for (unsigned int i = 0U; i < m_count; i++) {
+		const FEC_TABLE& table = m_tables[i];
+		if (::strcmp(table.m_name, name) != 0)
+			continue;
+
+		checksum = 0x811C9DC5U;
+
+		for (unsigned int j = 0U; j < table.m_length; j++) {
+			const unsigned char* entry = table.m_data + j * table.m_size;
+
+			unsigned int value = (table.m_size == 1U) ? *entry : *(const unsigned int*)entry;
+
+			for (unsigned int k = 0U; k < table.m_size; k++) {
+				checksum ^= (value >> (k * 8U)) & 0xFFU;
+				checksum *= 0x01000193U;
+			}
+		}
+
+		length = table.m_length;
+
+		return true;
+	}
+
+	return false;
+}
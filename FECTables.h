@@ -0,0 +1,65 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(FECTables_H)
+#define	FECTables_H
+
+// Helpers for building the tables of the cyclic codes from their generator
+// polynomials. The tables are built during static initialisation, so these
+// must not depend on any other static data.
+class CFECTables {
+public:
+	// The remainder after dividing an n bit pattern by a generator polynomial of the given degree
+	static unsigned int getRemainder(unsigned int pattern, unsigned int n, unsigned int generator, unsigned int degree);
+
+	// The systematic codeword, the data above the remainder
+	static unsigned int getCodeword(unsigned int data, unsigned int n, unsigned int generator, unsigned int degree);
+
+	static unsigned int getParity(unsigned int value);
+
+	// Fill in the error pattern for each syndrome, trying every pattern of up
+	// to maxWeight bits, lightest first and in lexicographic order within a
+	// weight, the first pattern found for a syndrome is kept. Syndromes that
+	// no pattern reaches are left as zero.
+	static void generateDecodingTable(unsigned int* table, unsigned int n, unsigned int generator, unsigned int degree, unsigned int maxWeight);
+
+	// Each table is registered once it is built, so that FECCheck can compare
+	// it with the literal table that it replaced
+	static void addTable(const char* name, const unsigned int* table, unsigned int length);
+	static void addTable(const char* name, const unsigned char* table, unsigned int length);
+
+	// The FNV-1a hash of a registered table, each entry is taken as little
+	// endian bytes of its own size. False if no table has the name.
+	static bool getChecksum(const char* name, unsigned int& length, unsigned int& checksum);
+
+private:
+	struct FEC_TABLE {
+		const char*          m_name;
+		const unsigned char* m_data;
+		unsigned int         m_size;
+		unsigned int         m_length;
+	};
+
+	static FEC_TABLE    m_tables[];
+	static unsigned int m_count;
+
+	static void addTable(const char* name, const unsigned char* data, unsigned int size, unsigned int length);
+	static void addPatterns(unsigned int* table, unsigned int pattern, unsigned int first, unsigned int weight, unsigned int n, unsigned int generator, unsigned int degree);
+};
+
+#endif
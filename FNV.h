@@ -0,0 +1,57 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef FNV_H
+#define FNV_H
+
+// A 32 bit FNV-1a hash, used by the check programs to compare a routine's
+// output over many inputs with the recorded output of the routine it replaced.
+// Values are added as little endian bytes, the same as CFECTables::getChecksum().
+class CFNV {
+public:
+	CFNV() :
+	m_hash(0x811C9DC5U)
+	{
+	}
+
+	void add(unsigned int value, unsigned int bytes)
+	{
+		for (unsigned int i = 0U; i < bytes; i++, value >>= 8) {
+			m_hash ^= value & 0xFFU;
+			m_hash *= 0x01000193U;
+		}
+	}
+
+	void add(const unsigned char* data, unsigned int length)
+	{
+		for (unsigned int i = 0U; i < length; i++) {
+			m_hash ^= data[i];
+			m_hash *= 0x01000193U;
+		}
+	}
+
+	unsigned int get() const
+	{
+		return m_hash;
+	}
+
+private:
+	unsigned int m_hash;
+};
+
+#endif
@@ -0,0 +1,343 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "FrameCapture.h"
+#include "Log.h"
+
+#include <chrono>
+
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <ctime>
+
+// Both DMR slots in both directions on the modem and the network, about 8kB/s
+const unsigned int CAPTURE_BYTES_PER_MINUTE = 512U * 1024U;
+
+// After an error has been written, further errors are only logged for this long
+const unsigned int CAPTURE_ERROR_HOLD_OFF_MS = 60000U;
+
+std::string        CFrameCapture::m_path;
+std::string        CFrameCapture::m_root;
+unsigned char*     CFrameCapture::m_buffer  = NULL;
+unsigned int       CFrameCapture::m_size    = 0U;
+unsigned int       CFrameCapture::m_used    = 0U;
+unsigned int       CFrameCapture::m_iPtr    = 0U;
+unsigned int       CFrameCapture::m_oPtr    = 0U;
+unsigned int       CFrameCapture::m_count   = 0U;
+unsigned long long CFrameCapture::m_window  = 0U;
+const char*        CFrameCapture::m_reason  = NULL;
+unsigned int       CFrameCapture::m_holdOff = 0U;
+
+CFrameCapture::CAPTURE_FILE CFrameCapture::m_file;
+bool                         CFrameCapture::m_pending = false;
+std::thread*                 CFrameCapture::m_thread  = NULL;
+std::mutex                   CFrameCapture::m_mutex;
+std::condition_variable      CFrameCapture::m_cond;
+bool                         CFrameCapture::m_running = false;
+
+static void setLE(unsigned char* p, unsigned long long value, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++, value >>= 8)
+		p[i] = (unsigned char)value;
+}
+
+static unsigned long long getLE(const unsigned char* p, unsigned int length)
+{
+	unsigned long long value = 0U;
+	for (unsigned int i = length; i > 0U; i--)
+		value = (value << 8) | p[i - 1U];
+
+	return value;
+}
+
+bool CFrameCapture::open(const std::string& path, const std::string& root, unsigned int minutes)
+{
+	assert(minutes > 0U);
+
+	m_path   = path;
+	m_root   = root;
+	m_size   = minutes * CAPTURE_BYTES_PER_MINUTE;
+	m_window = minutes * 60ULL * 1000000ULL;
+
+	m_buffer = new unsigned char[m_size];
+
+	m_used  = 0U;
+	m_iPtr  = 0U;
+	m_oPtr  = 0U;
+	m_count = 0U;
+
+	// Touched now so that taking a copy later costs no more than the copy itself
+	m_file.m_data = new unsigned char[CAPTURE_FILE_HEADER_LENGTH + m_size];
+	::memset(m_file.m_data, 0x00U, CAPTURE_FILE_HEADER_LENGTH + m_size);
+
+	m_pending = false;
+	m_running = true;
+	m_thread  = new std::thread(&CFrameCapture::writer);
+
+	return true;
+}
+
+void CFrameCapture::close()
+{
+	if (m_thread != NULL) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+
+		// Anything pending is written before the thread exits
+		m_cond.notify_one();
+
+		m_thread->join();
+		delete m_thread;
+		m_thread = NULL;
+	}
+
+	delete[] m_buffer;
+	m_buffer = NULL;
+
+	delete[] m_file.m_data;
+	m_file.m_data = NULL;
+}
+
+void CFrameCapture::add(CAPTURE_SOURCE source, CAPTURE_DIRECTION direction, unsigned int slot, unsigned char type, const unsigned char* data, unsigned int length)
+{
+	add(source, direction, slot, type, data, length, NULL, 0U);
+}
+
+void CFrameCapture::add(CAPTURE_SOURCE source, CAPTURE_DIRECTION direction, unsigned int slot, unsigned char type, const unsigned char* header, unsigned int headerLength, const unsigned char* data, unsigned int length)
+{
+	if (m_buffer == NULL)
+		return;
+
+	assert(header != NULL);
+	assert(headerLength + length <= CAPTURE_MAX_DATA_LENGTH);
+
+	unsigned int total = CAPTURE_RECORD_HEADER_LENGTH + headerLength + length;
+
+	// Make room by dropping the oldest frames
+	while (m_size - m_used < total)
+		remove();
+
+	unsigned char record[CAPTURE_RECORD_HEADER_LENGTH];
+	setLE(record + 0U, getTime(), 8U);
+	setLE(record + 8U, headerLength + length, 2U);
+	record[10U] = source;
+	record[11U] = direction;
+	record[12U] = slot;
+	record[13U] = type;
+	record[14U] = 0x00U;
+	record[15U] = 0x00U;
+
+	put(record, CAPTURE_RECORD_HEADER_LENGTH);
+	put(header, headerLength);
+	if (length > 0U)
+		put(data, length);
+
+	m_count++;
+}
+
+void CFrameCapture::request(const char* reason)
+{
+	assert(reason != NULL);
+
+	if (m_buffer == NULL)
+		return;
+
+	m_reason = reason;
+}
+
+void CFrameCapture::error(const char* reason)
+{
+	assert(reason != NULL);
+
+	if (m_buffer == NULL || m_holdOff > 0U)
+		return;
+
+	m_reason  = reason;
+	m_holdOff = CAPTURE_ERROR_HOLD_OFF_MS;
+}
+
+void CFrameCapture::clock(unsigned int ms)
+{
+	if (m_holdOff > ms)
+		m_holdOff -= ms;
+	else
+		m_holdOff = 0U;
+
+	if (m_reason == NULL)
+		return;
+
+	write();
+
+	m_reason = NULL;
+}
+
+unsigned long long CFrameCapture::getTime()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CFrameCapture::put(const unsigned char* data, unsigned int length)
+{
+	unsigned int first = m_size - m_iPtr;
+	if (first > length)
+		first = length;
+
+	::memcpy(m_buffer + m_iPtr, data, first);
+	::memcpy(m_buffer, data + first, length - first);
+
+	m_iPtr += length;
+	if (m_iPtr >= m_size)
+		m_iPtr -= m_size;
+
+	m_used += length;
+}
+
+void CFrameCapture::get(unsigned int ptr, unsigned char* data, unsigned int length)
+{
+	unsigned int first = m_size - ptr;
+	if (first > length)
+		first = length;
+
+	::memcpy(data, m_buffer + ptr, first);
+	::memcpy(data + first, m_buffer, length - first);
+}
+
+void CFrameCapture::remove()
+{
+	assert(m_count > 0U);
+
+	unsigned char record[CAPTURE_RECORD_HEADER_LENGTH];
+	get(m_oPtr, record, CAPTURE_RECORD_HEADER_LENGTH);
+
+	unsigned int total = CAPTURE_RECORD_HEADER_LENGTH + (unsigned int)getLE(record + 8U, 2U);
+
+	m_oPtr += total;
+	if (m_oPtr >= m_size)
+		m_oPtr -= m_size;
+
+	m_used -= total;
+	m_count--;
+}
+
+void CFrameCapture::write()
+{
+	unsigned long long now = getTime();
+	unsigned long long wallClock = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	// Leave out anything older than the window, the ring may hold more when it is quiet
+	while (m_count > 0U) {
+		unsigned char record[CAPTURE_RECORD_HEADER_LENGTH];
+		get(m_oPtr, record, CAPTURE_RECORD_HEADER_LENGTH);
+
+		if (now - getLE(record + 0U, 8U) <= m_window)
+			break;
+
+		remove();
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (m_pending) {
+		lock.unlock();
+		LogWarning("The last capture file is still being written, not writing another %s", m_reason);
+		return;
+	}
+
+	// Copy the ring here, the disk is left to the writer thread
+	m_file.m_length    = CAPTURE_FILE_HEADER_LENGTH + m_used;
+	m_file.m_count     = m_count;
+	m_file.m_wallClock = wallClock;
+	m_file.m_reason    = m_reason;
+
+	unsigned char* header = m_file.m_data;
+	::memcpy(header + 0U, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH);
+	setLE(header + 8U,  CAPTURE_VERSION, 4U);
+	setLE(header + 12U, m_count, 4U);
+	setLE(header + 16U, wallClock, 8U);
+	setLE(header + 24U, now, 8U);
+
+	get(m_oPtr, m_file.m_data + CAPTURE_FILE_HEADER_LENGTH, m_used);
+
+	m_pending = true;
+
+	lock.unlock();
+	m_cond.notify_one();
+}
+
+void CFrameCapture::writer()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (;;) {
+		while (m_running && !m_pending)
+			m_cond.wait(lock);
+
+		if (!m_pending)
+			break;
+
+		// Stays pending while it is written, so that the copy isn't overwritten by another request
+		lock.unlock();
+		writeFile();
+		lock.lock();
+
+		m_pending = false;
+	}
+}
+
+bool CFrameCapture::writeFile()
+{
+	time_t t = time_t(m_file.m_wallClock / 1000000ULL);
+
+	// The log writer thread uses gmtime() too
+	struct tm tm;
+#if defined(_WIN32) || defined(_WIN64)
+	::gmtime_s(&tm, &t);
+#else
+	::gmtime_r(&t, &tm);
+#endif
+
+	char filename[200U];
+#if defined(_WIN32) || defined(_WIN64)
+	::sprintf(filename, "%s\\%s-%04d-%02d-%02d-%02d%02d%02d.cap", m_path.c_str(), m_root.c_str(), tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+#else
+	::sprintf(filename, "%s/%s-%04d-%02d-%02d-%02d%02d%02d.cap", m_path.c_str(), m_root.c_str(), tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+#endif
+
+	FILE* fp = ::fopen(filename, "wb");
+	if (fp == NULL) {
+		LogError("Cannot open the capture file %s", filename);
+		return false;
+	}
+
+	::fwrite(m_file.m_data, 1U, m_file.m_length, fp);
+
+	bool ret = ::ferror(fp) == 0;
+	::fclose(fp);
+
+	if (!ret) {
+		LogError("Error when writing the capture file %s", filename);
+		return false;
+	}
+
+	LogMessage("Wrote %u frames to the capture file %s, %s", m_file.m_count, filename, m_file.m_reason);
+
+	return true;
+}
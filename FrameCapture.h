@@ -0,0 +1,116 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(FrameCapture_H)
+#define	FrameCapture_H
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <string>
+
+enum CAPTURE_SOURCE {
+	CS_MODEM,
+	CS_NETWORK
+};
+
+enum CAPTURE_DIRECTION {
+	CD_RX,
+	CD_TX
+};
+
+// The capture file is a file header followed by the records, oldest first, all
+// values are little endian.
+//
+// File header:   "MMDVMCAP", version (4), record count (4), the wall clock time
+//                when written (8, microseconds since 1970) and the capture
+//                clock at the same moment (8, microseconds)
+// Record header: capture clock (8, microseconds), data length (2), source (1),
+//                direction (1), slot (1, 0 if none), type (1), reserved (2)
+const char         CAPTURE_MAGIC[]              = "MMDVMCAP";
+const unsigned int CAPTURE_MAGIC_LENGTH         = 8U;
+const unsigned int CAPTURE_VERSION              = 1U;
+const unsigned int CAPTURE_FILE_HEADER_LENGTH   = 32U;
+const unsigned int CAPTURE_RECORD_HEADER_LENGTH = 16U;
+
+// The longest frame that is captured, the longest is a Homebrew config packet
+const unsigned int CAPTURE_MAX_DATA_LENGTH = 400U;
+
+// Keeps the last few minutes of modem and network frames in a ring in memory,
+// older frames are overwritten as new ones arrive. The ring is written to a
+// capture file when asked, or after an error, for later reading by
+// CaptureReader. Only for use from the main thread, the file itself is written
+// from a copy of the ring by a thread of its own.
+class CFrameCapture {
+public:
+	static bool open(const std::string& path, const std::string& root, unsigned int minutes);
+	static void close();
+
+	// Does nothing when the capture isn't open
+	static void add(CAPTURE_SOURCE source, CAPTURE_DIRECTION direction, unsigned int slot, unsigned char type, const unsigned char* data, unsigned int length);
+	static void add(CAPTURE_SOURCE source, CAPTURE_DIRECTION direction, unsigned int slot, unsigned char type, const unsigned char* header, unsigned int headerLength, const unsigned char* data, unsigned int length);
+
+	// The ring is written at the next clock(), requests after an error are
+	// ignored for a while after the last one was written
+	static void request(const char* reason);
+	static void error(const char* reason);
+
+	static void clock(unsigned int ms);
+
+private:
+	static std::string        m_path;
+	static std::string        m_root;
+	static unsigned char*     m_buffer;
+	static unsigned int       m_size;
+	static unsigned int       m_used;
+	static unsigned int       m_iPtr;
+	static unsigned int       m_oPtr;
+	static unsigned int       m_count;
+	static unsigned long long m_window;
+	static const char*        m_reason;
+	static unsigned int       m_holdOff;
+
+	// A copy of the ring for the writer thread, the header and records as they go to the disk
+	struct CAPTURE_FILE {
+		unsigned char*     m_data;
+		unsigned int       m_length;
+		unsigned int       m_count;
+		unsigned long long m_wallClock;
+		const char*        m_reason;
+	};
+
+	static CAPTURE_FILE            m_file;
+	static bool                    m_pending;
+	static std::thread*            m_thread;
+	static std::mutex              m_mutex;
+	static std::condition_variable m_cond;
+	static bool                    m_running;
+
+	static unsigned long long getTime();
+
+	static void put(const unsigned char* data, unsigned int length);
+	static void get(unsigned int ptr, unsigned char* data, unsigned int length);
+	static void remove();
+
+	static void write();
+
+	static void writer();
+	static bool writeFile();
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef FrameQueue_H
+#define FrameQueue_H
+
+#include <cassert>
+#include <cstring>
+
+// A queue of fixed length frames, each frame occupies one slot so there is no
+// length to store and the depth is simply a count of frames.
+template<unsigned int LENGTH> class CFrameQueue {
+public:
+	CFrameQueue(unsigned int frames) :
+	m_frames(frames + 1U),
+	m_buffer(NULL),
+	m_iPtr(0U),
+	m_oPtr(0U)
+	{
+		assert(frames > 0U);
+
+		m_buffer = new unsigned char[m_frames * LENGTH];
+
+		::memset(m_buffer, 0x00, m_frames * LENGTH);
+	}
+
+	~CFrameQueue()
+	{
+		delete[] m_buffer;
+	}
+
+	bool add(const unsigned char* frame)
+	{
+		assert(frame != NULL);
+
+		unsigned int iPtr = next(m_iPtr);
+		if (iPtr == m_oPtr)
+			return false;
+
+		::memcpy(m_buffer + m_iPtr * LENGTH, frame, LENGTH);
+		m_iPtr = iPtr;
+
+		return true;
+	}
+
+	bool get(unsigned char* frame)
+	{
+		assert(frame != NULL);
+
+		if (m_oPtr == m_iPtr)
+			return false;
+
+		::memcpy(frame, m_buffer + m_oPtr * LENGTH, LENGTH);
+		m_oPtr = next(m_oPtr);
+
+		return true;
+	}
+
+	// The oldest frame, it stays in the queue until remove() is called
+	const unsigned char* peek() const
+	{
+		if (m_oPtr == m_iPtr)
+			return NULL;
+
+		return m_buffer + m_oPtr * LENGTH;
+	}
+
+	void remove()
+	{
+		if (m_oPtr != m_iPtr)
+			m_oPtr = next(m_oPtr);
+	}
+
+	void clear()
+	{
+		m_iPtr = 0U;
+		m_oPtr = 0U;
+	}
+
+	unsigned int depth() const
+	{
+		if (m_iPtr >= m_oPtr)
+			return m_iPtr - m_oPtr;
+
+		return m_frames - (m_oPtr - m_iPtr);
+	}
+
+	unsigned int freeSpace() const
+	{
+		return m_frames - depth() - 1U;
+	}
+
+	bool hasSpace(unsigned int frames) const
+	{
+		return freeSpace() >= frames;
+	}
+
+	bool isEmpty() const
+	{
+		return m_oPtr == m_iPtr;
+	}
+
+private:
+	unsigned int   m_frames;
+	unsigned char* m_buffer;
+	unsigned int   m_iPtr;
+	unsigned int   m_oPtr;
+
+	CFrameQueue(const CFrameQueue&);
+	CFrameQueue& operator=(const CFrameQueue&);
+
+	unsigned int next(unsigned int ptr) const
+	{
+		ptr++;
+		if (ptr == m_frames)
+			ptr = 0U;
+
+		return ptr;
+	}
+};
+
+#endif
@@ -34,7 +34,7 @@ CFullLC::~CFullLC()
 {
 }
 
-CLC* CFullLC::decode(const unsigned char* data, unsigned char type)
+bool CFullLC::decode(const unsigned char* data, unsigned char type, CLC& lc)
 {
 	assert(data != NULL);
 
@@ -56,17 +56,20 @@ CLC* CFullLC::decode(const unsigned char* data, unsigned char type)
 
 		default:
 			::LogError("Unsupported LC type - %d", int(type));
-			return NULL;
+			return false;
 	}
 
-	if (!CRS129::check(lcData)) {
+	// Corrects a single bad byte
+	if (!CRS129::decode(lcData)) {
 		::LogDebug("Checksum failed for the LC");
-		CLC lc(lcData);
-		LogDebug("Invalid LC, src = %u, dst = %s%u", lc.getSrcId(), lc.getFLCO() == FLCO_GROUP ? "TG " : "", lc.getDstId());
-		return NULL;
+		CLC invalid(lcData);
+		LogDebug("Invalid LC, src = %u, dst = %s%u", invalid.getSrcId(), invalid.getFLCO() == FLCO_GROUP ? "TG " : "", invalid.getDstId());
+		return false;
 	}
 
-	return new CLC(lcData);
+	lc = CLC(lcData);
+
+	return true;
 }
 
 void CFullLC::encode(const CLC& lc, unsigned char* data, unsigned char type)
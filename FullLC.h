@@ -30,7 +30,7 @@ public:
 	CFullLC();
 	~CFullLC();
 
-	CLC* decode(const unsigned char* data, unsigned char type);
+	bool decode(const unsigned char* data, unsigned char type, CLC& lc);
 
 	void encode(const CLC& lc, unsigned char* data, unsigned char type);
 
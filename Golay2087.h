@@ -25,6 +25,9 @@ public:
 
 	static unsigned char decode(const unsigned char* data);
 
+	// Decode count codewords of three bytes each in one call
+	static void decode(const unsigned char* data, unsigned char* out, unsigned int count);
+
 private:
 	static unsigned int getSyndrome1987(unsigned int pattern);
 };
@@ -26,6 +26,10 @@ public:
 
 	static unsigned int decode23127(unsigned int code);
 	static unsigned int decode24128(unsigned int code);
+
+	// Decode count codewords in one call
+	static void decode23127(const unsigned int* code, unsigned int* data, unsigned int count);
+	static void decode24128(const unsigned int* code, unsigned int* data, unsigned int count);
 };
 
 #endif
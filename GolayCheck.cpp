@@ -0,0 +1,191 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Runs every possible received word through the Golay (23,12), (24,12) and
+// (20,8) and the QR (16,7,6) decoders, one at a time and in batches, and
+// compares the hash of the results with that recorded from the decoders that
+// computed the syndrome with a shift and XOR loop.
+
+#include "Golay24128.h"
+#include "Golay2087.h"
+#include "QR1676.h"
+#include "FNV.h"
+
+#include <cstdio>
+
+const unsigned int DECODE_23127_CHECKSUM = 0x0D1A9845U;
+const unsigned int DECODE_24128_CHECKSUM = 0x4C2AB805U;
+const unsigned int DECODE_2087_CHECKSUM  = 0x1D7F5BE5U;
+const unsigned int DECODE_1676_CHECKSUM  = 0x745761C5U;
+
+const unsigned int BATCH_LENGTH = 4096U;
+
+static unsigned int hashDecode23127()
+{
+	CFNV fnv;
+
+	for (unsigned int code = 0U; code < 0x800000U; code++)
+		fnv.add(CGolay24128::decode23127(code), 2U);
+
+	return fnv.get();
+}
+
+static unsigned int hashDecode23127Batch()
+{
+	unsigned int code[BATCH_LENGTH];
+	unsigned int data[BATCH_LENGTH];
+
+	CFNV fnv;
+
+	for (unsigned int first = 0U; first < 0x800000U; first += BATCH_LENGTH) {
+		for (unsigned int i = 0U; i < BATCH_LENGTH; i++)
+			code[i] = first + i;
+
+		CGolay24128::decode23127(code, data, BATCH_LENGTH);
+
+		for (unsigned int i = 0U; i < BATCH_LENGTH; i++)
+			fnv.add(data[i], 2U);
+	}
+
+	return fnv.get();
+}
+
+static unsigned int hashDecode24128()
+{
+	CFNV fnv;
+
+	for (unsigned int code = 0U; code < 0x1000000U; code++)
+		fnv.add(CGolay24128::decode24128(code), 2U);
+
+	return fnv.get();
+}
+
+static unsigned int hashDecode24128Batch()
+{
+	unsigned int code[BATCH_LENGTH];
+	unsigned int data[BATCH_LENGTH];
+
+	CFNV fnv;
+
+	for (unsigned int first = 0U; first < 0x1000000U; first += BATCH_LENGTH) {
+		for (unsigned int i = 0U; i < BATCH_LENGTH; i++)
+			code[i] = first + i;
+
+		CGolay24128::decode24128(code, data, BATCH_LENGTH);
+
+		for (unsigned int i = 0U; i < BATCH_LENGTH; i++)
+			fnv.add(data[i], 2U);
+	}
+
+	return fnv.get();
+}
+
+// The 20 bits of a (20,8) codeword are at the top of three bytes
+static void setCode2087(unsigned int code, unsigned char* data)
+{
+	data[0U] = code >> 12;
+	data[1U] = code >> 4;
+	data[2U] = code << 4;
+}
+
+static unsigned int hashDecode2087()
+{
+	CFNV fnv;
+
+	for (unsigned int code = 0U; code < 0x100000U; code++) {
+		unsigned char data[3U];
+		setCode2087(code, data);
+
+		fnv.add(CGolay2087::decode(data), 1U);
+	}
+
+	return fnv.get();
+}
+
+static unsigned int hashDecode2087Batch()
+{
+	static unsigned char data[BATCH_LENGTH * 3U];
+	unsigned char out[BATCH_LENGTH];
+
+	CFNV fnv;
+
+	for (unsigned int first = 0U; first < 0x100000U; first += BATCH_LENGTH) {
+		for (unsigned int i = 0U; i < BATCH_LENGTH; i++)
+			setCode2087(first + i, data + i * 3U);
+
+		CGolay2087::decode(data, out, BATCH_LENGTH);
+
+		fnv.add(out, BATCH_LENGTH);
+	}
+
+	return fnv.get();
+}
+
+static unsigned int hashDecode1676()
+{
+	CFNV fnv;
+
+	for (unsigned int code = 0U; code < 0x10000U; code++) {
+		unsigned char data[2U];
+		data[0U] = code >> 8;
+		data[1U] = code;
+
+		fnv.add(CQR1676::decode(data), 1U);
+	}
+
+	return fnv.get();
+}
+
+static bool check(const char* name, unsigned int checksum, unsigned int expected)
+{
+	if (checksum != expected) {
+		::fprintf(stdout, "%-24s FAILED, checksum 0x%08X, expected 0x%08X\n", name, checksum, expected);
+		return false;
+	}
+
+	::fprintf(stdout, "%-24s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failed = 0U;
+
+	if (!check("decode23127", hashDecode23127(), DECODE_23127_CHECKSUM))
+		failed++;
+	if (!check("decode23127 batch", hashDecode23127Batch(), DECODE_23127_CHECKSUM))
+		failed++;
+	if (!check("decode24128", hashDecode24128(), DECODE_24128_CHECKSUM))
+		failed++;
+	if (!check("decode24128 batch", hashDecode24128Batch(), DECODE_24128_CHECKSUM))
+		failed++;
+	if (!check("CGolay2087::decode", hashDecode2087(), DECODE_2087_CHECKSUM))
+		failed++;
+	if (!check("CGolay2087::decode batch", hashDecode2087Batch(), DECODE_2087_CHECKSUM))
+		failed++;
+	if (!check("CQR1676::decode", hashDecode1676(), DECODE_1676_CHECKSUM))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u decoders differ from the shift and XOR decoders\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
@@ -18,211 +18,249 @@
 
 #include "Hamming.h"
 
+#include <cstdio>
+#include <cassert>
+
+// Each check mask covers the bits that make up one parity bit plus the parity
+// bit itself, so the parity of the masked word is one bit of the syndrome. The
+// error masks give the bit to flip for each syndrome, or zero if no single bit
+// error has that syndrome.
+const unsigned int CHECK_MASKS_15113[] = {0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U};
+const unsigned int ERROR_MASKS_15113[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	 0x0001U, 0x4000U, 0x0100U, 0x2000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const unsigned int CHECK_MASKS_1393[] = {0x1AC8U, 0x1D64U, 0x1EB2U, 0x1591U};
+const unsigned int ERROR_MASKS_1393[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	 0x0001U, 0x0000U, 0x0100U, 0x0000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const unsigned int CHECK_MASKS_16114[] = {0xF590U, 0x7AC8U, 0x3D64U, 0xEB22U, 0xA6E1U};
+const unsigned int ERROR_MASKS_16114[] =
+	{0x0000U, 0x0010U, 0x0008U, 0x0000U, 0x0004U, 0x0000U, 0x0000U, 0x1000U,
+	 0x0002U, 0x0000U, 0x0000U, 0x4000U, 0x0000U, 0x0100U, 0x0800U, 0x0000U,
+	 0x0001U, 0x0000U, 0x0000U, 0x0080U, 0x0000U, 0x0400U, 0x0040U, 0x0000U,
+	 0x0000U, 0x8000U, 0x0200U, 0x0000U, 0x0020U, 0x0000U, 0x0000U, 0x2000U};
+
+const unsigned int CHECK_MASKS_17123[] = {0x1E690U, 0x1F348U, 0x0F9A4U, 0x19A42U, 0x1CD21U};
+const unsigned int ERROR_MASKS_17123[] =
+	{0x00000U, 0x00010U, 0x00008U, 0x00000U, 0x00004U, 0x00080U, 0x00000U, 0x02000U,
+	 0x00002U, 0x00000U, 0x00040U, 0x00200U, 0x00000U, 0x00000U, 0x01000U, 0x00000U,
+	 0x00001U, 0x00400U, 0x00000U, 0x00000U, 0x00020U, 0x00000U, 0x00100U, 0x04000U,
+	 0x00000U, 0x00000U, 0x00000U, 0x10000U, 0x00800U, 0x00000U, 0x00000U, 0x08000U};
+
+static unsigned int parity(unsigned int word)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	word ^= word >> 16;
+	word ^= word >> 8;
+	word ^= word >> 4;
+
+	return (0x6996U >> (word & 0x0FU)) & 0x01U;
+#else
+	return __builtin_parity(word);
+#endif
+}
+
+// The syndrome, the first check in bit 0
+static unsigned int syndrome(unsigned int word, const unsigned int* masks, unsigned int n)
+{
+	unsigned int s = 0x00U;
+	for (unsigned int i = 0U; i < n; i++)
+		s |= parity(word & masks[i]) << i;
+
+	return s;
+}
+
+// The parity bits of a word whose parity bits are clear, in their places at the bottom of the word
+static unsigned int checkBits(unsigned int word, const unsigned int* masks, unsigned int n)
+{
+	unsigned int p = 0x00U;
+	for (unsigned int i = 0U; i < n; i++)
+		p = (p << 1) | parity(word & masks[i]);
+
+	return p;
+}
+
+static unsigned int pack(const bool* d, unsigned int n)
+{
+	unsigned int word = 0U;
+	for (unsigned int i = 0U; i < n; i++)
+		word = (word << 1) | (d[i] ? 0x01U : 0x00U);
+
+	return word;
+}
+
+static void unpack(unsigned int word, bool* d, unsigned int n)
+{
+	for (unsigned int i = 0U; i < n; i++)
+		d[i] = ((word >> (n - 1U - i)) & 0x01U) == 0x01U;
+}
+
 // Hamming (15,11,3) check a boolean data array
 bool CHamming::decode15113(bool* d)
 {
-	// Calculate the checksum this row should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-
-	unsigned char n = 0x00U;
-	n |= (c0 != d[11]) ? 0x01U : 0x00U;
-	n |= (c1 != d[12]) ? 0x02U : 0x00U;
-	n |= (c2 != d[13]) ? 0x04U : 0x00U;
-	n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[11] = !d[11]; return true;
-		case 0x02U: d[12] = !d[12]; return true;
-		case 0x04U: d[13] = !d[13]; return true;
-		case 0x08U: d[14] = !d[14]; return true;
-
-		// Data bit errors
-		case 0x09U: d[0]  = !d[0];  return true;
-		case 0x0BU: d[1]  = !d[1];  return true;
-		case 0x0FU: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x05U: d[5]  = !d[5];  return true;
-		case 0x0AU: d[6]  = !d[6];  return true;
-		case 0x0DU: d[7]  = !d[7];  return true;
-		case 0x03U: d[8]  = !d[8];  return true;
-		case 0x06U: d[9]  = !d[9];  return true;
-		case 0x0CU: d[10] = !d[10]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	assert(d != NULL);
+
+	unsigned int word = pack(d, 15U);
+	unsigned int orig = word;
+
+	bool ret = decode15113(word);
+
+	if (word != orig)
+		unpack(word, d, 15U);
+
+	return ret;
 }
 
 void CHamming::encode15113(bool* d)
 {
-	// Calculate the checksum this row should have
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+	assert(d != NULL);
+
+	unpack(encode15113(pack(d, 15U)), d, 15U);
+}
+
+// Returns true if a bit error was corrected
+bool CHamming::decode15113(unsigned int& word)
+{
+	unsigned int error = ERROR_MASKS_15113[syndrome(word, CHECK_MASKS_15113, 4U)];
+
+	word ^= error;
+
+	return error != 0U;
+}
+
+unsigned int CHamming::encode15113(unsigned int word)
+{
+	word &= 0x7FF0U;
+
+	return word | checkBits(word, CHECK_MASKS_15113, 4U);
 }
 
 // Hamming (13,9,3) check a boolean data array
 bool CHamming::decode1393(bool* d)
 {
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-	bool c1 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-	bool c2 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c3 = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
-	
-	unsigned char n = 0x00U;
-	n |= (c0 != d[9])  ? 0x01U : 0x00U;
-	n |= (c1 != d[10]) ? 0x02U : 0x00U;
-	n |= (c2 != d[11]) ? 0x04U : 0x00U;
-	n |= (c3 != d[12]) ? 0x08U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[9]  = !d[9];  return true;
-		case 0x02U: d[10] = !d[10]; return true;
-		case 0x04U: d[11] = !d[11]; return true;
-		case 0x08U: d[12] = !d[12]; return true;
-
-		// Data bit erros
-		case 0x0FU: d[0] = !d[0]; return true;
-		case 0x07U: d[1] = !d[1]; return true;
-		case 0x0EU: d[2] = !d[2]; return true;
-		case 0x05U: d[3] = !d[3]; return true;
-		case 0x0AU: d[4] = !d[4]; return true;
-		case 0x0DU: d[5] = !d[5]; return true;
-		case 0x03U: d[6] = !d[6]; return true;
-		case 0x06U: d[7] = !d[7]; return true;
-		case 0x0CU: d[8] = !d[8]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	assert(d != NULL);
+
+	unsigned int word = pack(d, 13U);
+	unsigned int orig = word;
+
+	bool ret = decode1393(word);
+
+	if (word != orig)
+		unpack(word, d, 13U);
+
+	return ret;
 }
 
 void CHamming::encode1393(bool* d)
 {
-	// Calculate the checksum this column should have
-	d[9]  = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-	d[10] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+	assert(d != NULL);
+
+	unpack(encode1393(pack(d, 13U)), d, 13U);
+}
+
+// Returns true if a bit error was corrected
+bool CHamming::decode1393(unsigned int& word)
+{
+	unsigned int error = ERROR_MASKS_1393[syndrome(word, CHECK_MASKS_1393, 4U)];
+
+	word ^= error;
+
+	return error != 0U;
+}
+
+unsigned int CHamming::encode1393(unsigned int word)
+{
+	word &= 0x1FF0U;
+
+	return word | checkBits(word, CHECK_MASKS_1393, 4U);
 }
 
-// A Hamming (16,11,4) Check
+// Hamming (16,11,4) check a boolean data array
 bool CHamming::decode16114(bool* d)
 {
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-	bool c4 = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
-
-	// Compare these with the actual bits
-	unsigned char n = 0x00U;
-	n |= (c0 != d[11]) ? 0x01U : 0x00U;
-	n |= (c1 != d[12]) ? 0x02U : 0x00U;
-	n |= (c2 != d[13]) ? 0x04U : 0x00U;
-	n |= (c3 != d[14]) ? 0x08U : 0x00U;
-	n |= (c4 != d[15]) ? 0x10U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[11] = !d[11]; return true;
-		case 0x02U: d[12] = !d[12]; return true;
-		case 0x04U: d[13] = !d[13]; return true;
-		case 0x08U: d[14] = !d[14]; return true;
-		case 0x10U: d[15] = !d[15]; return true;
-
-		// Data bit errors
-		case 0x19U: d[0]  = !d[0];  return true;
-		case 0x0BU: d[1]  = !d[1];  return true;
-		case 0x1FU: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x15U: d[5]  = !d[5];  return true;
-		case 0x1AU: d[6]  = !d[6];  return true;
-		case 0x0DU: d[7]  = !d[7];  return true;
-		case 0x13U: d[8]  = !d[8];  return true;
-		case 0x16U: d[9]  = !d[9];  return true;
-		case 0x1CU: d[10] = !d[10]; return true;
-
-		// No bit errors
-		case 0x00U: return true;
-
-		// Unrecoverable errors
-		default: return false;
-	}
+	assert(d != NULL);
+
+	unsigned int word = pack(d, 16U);
+	unsigned int orig = word;
+
+	bool ret = decode16114(word);
+
+	if (word != orig)
+		unpack(word, d, 16U);
+
+	return ret;
 }
 
 void CHamming::encode16114(bool* d)
 {
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-	d[15] = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+	assert(d != NULL);
+
+	unpack(encode16114(pack(d, 16U)), d, 16U);
 }
 
-// A Hamming (17,12,3) Check
+// Returns false if the errors are unrecoverable
+bool CHamming::decode16114(unsigned int& word)
+{
+	unsigned int s = syndrome(word, CHECK_MASKS_16114, 5U);
+	if (s == 0x00U)
+		return true;
+
+	unsigned int error = ERROR_MASKS_16114[s];
+
+	word ^= error;
+
+	return error != 0U;
+}
+
+unsigned int CHamming::encode16114(unsigned int word)
+{
+	word &= 0xFFE0U;
+
+	return word | checkBits(word, CHECK_MASKS_16114, 5U);
+}
+
+// Hamming (17,12,3) check a boolean data array
 bool CHamming::decode17123(bool* d)
 {
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-	bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-	bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-	bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-	bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
-
-	// Compare these with the actual bits
-	unsigned char n = 0x00U;
-	n |= (c0 != d[12]) ? 0x01U : 0x00U;
-	n |= (c1 != d[13]) ? 0x02U : 0x00U;
-	n |= (c2 != d[14]) ? 0x04U : 0x00U;
-	n |= (c3 != d[15]) ? 0x08U : 0x00U;
-	n |= (c4 != d[16]) ? 0x10U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[12] = !d[12]; return true;
-		case 0x02U: d[13] = !d[13]; return true;
-		case 0x04U: d[14] = !d[14]; return true;
-		case 0x08U: d[15] = !d[15]; return true;
-		case 0x10U: d[16] = !d[16]; return true;
-
-		// Data bit errors
-		case 0x1BU: d[0]  = !d[0];  return true;
-		case 0x1FU: d[1]  = !d[1];  return true;
-		case 0x17U: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x1CU: d[5]  = !d[5];  return true;
-		case 0x11U: d[6]  = !d[6];  return true;
-		case 0x0BU: d[7]  = !d[7];  return true;
-		case 0x16U: d[8]  = !d[8];  return true;
-		case 0x05U: d[9]  = !d[9];  return true;
-		case 0x0AU: d[10] = !d[10]; return true;
-		case 0x14U: d[11] = !d[11]; return true;
-
-		// No bit errors
-		case 0x00U: return true;
-
-		// Unrecoverable errors
-		default: return false;
-	}
+	assert(d != NULL);
+
+	unsigned int word = pack(d, 17U);
+	unsigned int orig = word;
+
+	bool ret = decode17123(word);
+
+	if (word != orig)
+		unpack(word, d, 17U);
+
+	return ret;
 }
 
 void CHamming::encode17123(bool* d)
 {
-	d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-	d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-	d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-	d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-	d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+	assert(d != NULL);
+
+	unpack(encode17123(pack(d, 17U)), d, 17U);
+}
+
+// Returns false if the errors are unrecoverable
+bool CHamming::decode17123(unsigned int& word)
+{
+	unsigned int s = syndrome(word, CHECK_MASKS_17123, 5U);
+	if (s == 0x00U)
+		return true;
+
+	unsigned int error = ERROR_MASKS_17123[s];
+
+	word ^= error;
+
+	return error != 0U;
+}
+
+unsigned int CHamming::encode17123(unsigned int word)
+{
+	word &= 0x1FFE0U;
+
+	return word | checkBits(word, CHECK_MASKS_17123, 5U);
 }
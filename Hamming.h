@@ -32,6 +32,20 @@ public:
 
 	static void encode17123(bool* d);
 	static bool decode17123(bool* d);
+
+	// The same codes on packed words, d[0] in the most significant bit and
+	// the parity bits at the bottom. Encoding ignores the parity bits passed in.
+	static unsigned int encode15113(unsigned int word);
+	static bool decode15113(unsigned int& word);
+
+	static unsigned int encode1393(unsigned int word);
+	static bool decode1393(unsigned int& word);
+
+	static unsigned int encode16114(unsigned int word);
+	static bool decode16114(unsigned int& word);
+
+	static unsigned int encode17123(unsigned int word);
+	static bool decode17123(unsigned int& word);
 };
 
 #endif
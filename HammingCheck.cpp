@@ -0,0 +1,159 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Runs every possible word through the Hamming encoders and decoders, through
+// both the bool array adapters and the packed word API, and compares the hash
+// of the results with that recorded from the bool array routines they replaced.
+
+#include "Hamming.h"
+#include "FNV.h"
+
+#include <cstdio>
+
+struct HAMMING_CODE {
+	const char*  m_name;
+	unsigned int m_n;
+	void (*m_encodeBits)(bool*);
+	bool (*m_decodeBits)(bool*);
+	unsigned int (*m_encodeWord)(unsigned int);
+	bool (*m_decodeWord)(unsigned int&);
+	unsigned int m_encodeChecksum;
+	unsigned int m_decodeChecksum;
+};
+
+const HAMMING_CODE CODES[] = {
+	{"15113", 15U, CHamming::encode15113, CHamming::decode15113, CHamming::encode15113, CHamming::decode15113, 0x330EF4C5U, 0xD337EEC5U},
+	{"1393",  13U, CHamming::encode1393,  CHamming::decode1393,  CHamming::encode1393,  CHamming::decode1393,  0x58EE43C5U, 0x662A5C45U},
+	{"16114", 16U, CHamming::encode16114, CHamming::decode16114, CHamming::encode16114, CHamming::decode16114, 0x8C64EAC5U, 0x35977005U},
+	{"17123", 17U, CHamming::encode17123, CHamming::decode17123, CHamming::encode17123, CHamming::decode17123, 0xECBA04C5U, 0x7FE4C685U}};
+
+// The first bit of the array is the most significant bit of the word
+static void unpack(unsigned int word, bool* bits, unsigned int n)
+{
+	for (unsigned int i = 0U; i < n; i++)
+		bits[i] = (word & (1U << (n - 1U - i))) != 0U;
+}
+
+static unsigned int pack(const bool* bits, unsigned int n)
+{
+	unsigned int word = 0U;
+	for (unsigned int i = 0U; i < n; i++)
+		word = (word << 1) | (bits[i] ? 1U : 0U);
+
+	return word;
+}
+
+static unsigned int hashEncodeBits(const HAMMING_CODE& code)
+{
+	CFNV fnv;
+
+	for (unsigned int word = 0U; word < (1U << code.m_n); word++) {
+		bool bits[17U];
+		unpack(word, bits, code.m_n);
+
+		code.m_encodeBits(bits);
+
+		fnv.add(pack(bits, code.m_n), 3U);
+	}
+
+	return fnv.get();
+}
+
+static unsigned int hashEncodeWord(const HAMMING_CODE& code)
+{
+	CFNV fnv;
+
+	for (unsigned int word = 0U; word < (1U << code.m_n); word++)
+		fnv.add(code.m_encodeWord(word), 3U);
+
+	return fnv.get();
+}
+
+static unsigned int hashDecodeBits(const HAMMING_CODE& code)
+{
+	CFNV fnv;
+
+	for (unsigned int word = 0U; word < (1U << code.m_n); word++) {
+		bool bits[17U];
+		unpack(word, bits, code.m_n);
+
+		bool ret = code.m_decodeBits(bits);
+
+		fnv.add(pack(bits, code.m_n), 3U);
+		fnv.add(ret ? 1U : 0U, 1U);
+	}
+
+	return fnv.get();
+}
+
+static unsigned int hashDecodeWord(const HAMMING_CODE& code)
+{
+	CFNV fnv;
+
+	for (unsigned int word = 0U; word < (1U << code.m_n); word++) {
+		unsigned int decoded = word;
+		bool ret = code.m_decodeWord(decoded);
+
+		fnv.add(decoded, 3U);
+		fnv.add(ret ? 1U : 0U, 1U);
+	}
+
+	return fnv.get();
+}
+
+static bool check(const char* name, const char* api, unsigned int checksum, unsigned int expected)
+{
+	if (checksum != expected) {
+		::fprintf(stdout, "%-12s %-6s FAILED, checksum 0x%08X, expected 0x%08X\n", name, api, checksum, expected);
+		return false;
+	}
+
+	::fprintf(stdout, "%-12s %-6s OK\n", name, api);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failed = 0U;
+
+	for (unsigned int i = 0U; i < sizeof(CODES) / sizeof(HAMMING_CODE); i++) {
+		const HAMMING_CODE& code = CODES[i];
+
+		char name[20U];
+
+		::sprintf(name, "encode%s", code.m_name);
+		if (!check(name, "bool", hashEncodeBits(code), code.m_encodeChecksum))
+			failed++;
+		if (!check(name, "packed", hashEncodeWord(code), code.m_encodeChecksum))
+			failed++;
+
+		::sprintf(name, "decode%s", code.m_name);
+		if (!check(name, "bool", hashDecodeBits(code), code.m_decodeChecksum))
+			failed++;
+		if (!check(name, "packed", hashDecodeWord(code), code.m_decodeChecksum))
+			failed++;
+	}
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u Hamming routines differ from the bool array routines\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
@@ -20,6 +20,7 @@
 #include "StopWatch.h"
 #include "SHA256.h"
 #include "Utils.h"
+#include "FrameCapture.h"
 #include "Log.h"
 
 #include <cassert>
@@ -27,6 +28,13 @@
 const unsigned int BUFFER_LENGTH = 500U;
 
 const unsigned int HOMEBREW_DATA_PACKET_LENGTH = 53U;
+const unsigned int HOMEBREW_DATA_HEADER_LENGTH = 20U;
+
+// Room for about a second of packets on both slots, now that bursts are read straight away
+const unsigned int RX_DATA_LENGTH = 50U * (HOMEBREW_DATA_PACKET_LENGTH + 1U);
+
+// A flood from the master must not hold up the rest of the loop, whatever is left is read next time
+const unsigned int MAX_BATCHES_PER_CLOCK = 4U;
 
 
 CHomebrewDMRIPSC::CHomebrewDMRIPSC(const std::string& address, unsigned int port, unsigned int id, const std::string& password, const char* software, const char* version, bool debug) :
@@ -45,7 +53,8 @@ m_pingTimer(1000U, 5U),
 m_buffer(NULL),
 m_salt(NULL),
 m_streamId(NULL),
-m_rxData(1000U),
+m_rxBuffer(NULL),
+m_rxData(RX_DATA_LENGTH),
 m_callsign(),
 m_rxFrequency(0U),
 m_txFrequency(0U),
@@ -57,7 +66,11 @@ m_height(0),
 m_location(),
 m_description(),
 m_url(),
-m_beacon(false)
+m_beacon(false),
+m_rxBatches(0U),
+m_rxPackets(0U),
+m_rxMaxBatch(0U),
+m_rxFullBatches(0U)
 {
 	assert(!address.empty());
 	assert(port > 0U);
@@ -67,6 +80,7 @@ m_beacon(false)
 	m_address = CUDPSocket::lookup(address);
 
 	m_buffer   = new unsigned char[BUFFER_LENGTH];
+	m_rxBuffer = new unsigned char[UDP_MAX_BATCH * BUFFER_LENGTH];
 	m_salt     = new unsigned char[sizeof(uint32_t)];
 	m_id       = new uint8_t[4U];
 	m_streamId = new uint32_t[2U];
@@ -86,6 +100,7 @@ m_beacon(false)
 CHomebrewDMRIPSC::~CHomebrewDMRIPSC()
 {
 	delete[] m_buffer;
+	delete[] m_rxBuffer;
 	delete[] m_salt;
 	delete[] m_streamId;
 	delete[] m_id;
@@ -187,8 +202,9 @@ bool CHomebrewDMRIPSC::write(const CDMRData& data)
 	if (m_status != RUNNING)
 		return false;
 
-	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
-	::memset(buffer, 0x00U, HOMEBREW_DATA_PACKET_LENGTH);
+	// The frame itself is sent from where it is, only the header is built here
+	unsigned char buffer[HOMEBREW_DATA_HEADER_LENGTH];
+	::memset(buffer, 0x00U, HOMEBREW_DATA_HEADER_LENGTH);
 
 	buffer[0U]  = 'D';
 	buffer[1U]  = 'M';
@@ -231,9 +247,7 @@ bool CHomebrewDMRIPSC::write(const CDMRData& data)
 
 	::memcpy(buffer + 16U, m_streamId + slotIndex, 4U);
 
-	data.getData(buffer + 20U);
-
-	return write(buffer, HOMEBREW_DATA_PACKET_LENGTH);
+	return write(buffer, HOMEBREW_DATA_HEADER_LENGTH, data.getData(), DMR_FRAME_LENGTH_BYTES);
 }
 
 void CHomebrewDMRIPSC::close()
@@ -248,71 +262,46 @@ void CHomebrewDMRIPSC::close()
 	m_socket.close();
 }
 
+void CHomebrewDMRIPSC::printStats()
+{
+	if (m_rxBatches > 0U)
+		LogDebug("DMR network datagrams received: %u in %u batches, average %.1f/batch, maximum %u/batch, %u full batches", m_rxPackets, m_rxBatches, float(m_rxPackets) / float(m_rxBatches), m_rxMaxBatch, m_rxFullBatches);
+
+	m_rxBatches     = 0U;
+	m_rxPackets     = 0U;
+	m_rxMaxBatch    = 0U;
+	m_rxFullBatches = 0U;
+}
+
+int CHomebrewDMRIPSC::getFd() const
+{
+	return m_socket.getFd();
+}
+
 void CHomebrewDMRIPSC::clock(unsigned int ms)
 {
-	in_addr address;
-	unsigned int port;
-	int length = m_socket.read(m_buffer, BUFFER_LENGTH, address, port);
+	unsigned int lengths[UDP_MAX_BATCH];
+	in_addr addresses[UDP_MAX_BATCH];
+	unsigned int ports[UDP_MAX_BATCH];
 
-	if (m_debug && length > 0)
-		CUtils::dump(1U, "IPSC Received", m_buffer, length);
+	// Take what is waiting, so that a burst from the master isn't left in the kernel
+	for (unsigned int batches = 0U; batches < MAX_BATCHES_PER_CLOCK; batches++) {
+		int n = m_socket.readBatch(m_rxBuffer, BUFFER_LENGTH, UDP_MAX_BATCH, lengths, addresses, ports);
+		if (n <= 0)
+			break;
 
-	if (length > 0 && m_address.s_addr == address.s_addr && m_port == port) {
-		if (::memcmp(m_buffer, "DMRD", 4U) == 0) {
-			unsigned char len = length;
-			m_rxData.addData(&len, 1U);
-			m_rxData.addData(m_buffer, len);
-		} else if (::memcmp(m_buffer, "MSTNAK",  6U) == 0) {
-			if (m_status == RUNNING) {
-				LogWarning("The master is restarting, logging back in");
-				m_status = WAITING_LOGIN;
-				m_timeoutTimer.start();
-				m_retryTimer.start();
-				m_pingTimer.stop();
-			} else {
-				LogError("Login to the master has failed");
-				m_status = DISCONNECTED;
-				m_timeoutTimer.stop();
-				m_retryTimer.stop();
-				m_pingTimer.stop();
-			}
-		} else if (::memcmp(m_buffer, "RPTACK",  6U) == 0) {
-			switch (m_status) {
-				case WAITING_LOGIN:
-					::memcpy(m_salt, m_buffer + 6U, sizeof(uint32_t));  
-					writeAuthorisation();
-					m_status = WAITING_AUTHORISATION;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_AUTHORISATION:
-					writeConfig();
-					m_status = WAITING_CONFIG;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_CONFIG:
-					LogMessage("Logged into the master succesfully");
-					m_status = RUNNING;
-					m_timeoutTimer.start();
-					m_retryTimer.stop();
-					m_pingTimer.start();
-					break;
-				default:
-					break;
-			}
-		} else if (::memcmp(m_buffer, "MSTCL",   5U) == 0) {
-			LogError("Master is closing down");
-			m_status = DISCONNECTED;		// XXX
-			m_timeoutTimer.stop();
-			m_retryTimer.stop();
-		} else if (::memcmp(m_buffer, "MSTPONG", 7U) == 0) {
-			m_timeoutTimer.start();
-		} else if (::memcmp(m_buffer, "RPTSBKN", 7U) == 0) {
-			m_beacon = true;
-		} else {
-			CUtils::dump("Unknown packet from the master", m_buffer, length);
-		}
+		m_rxBatches++;
+		m_rxPackets += n;
+		if ((unsigned int)n > m_rxMaxBatch)
+			m_rxMaxBatch = n;
+
+		for (int i = 0; i < n; i++)
+			processPacket(m_rxBuffer + i * BUFFER_LENGTH, lengths[i], addresses[i], ports[i]);
+
+		if ((unsigned int)n < UDP_MAX_BATCH)
+			break;
+
+		m_rxFullBatches++;
 	}
 
 	if (m_status != RUNNING) {
@@ -345,12 +334,106 @@ void CHomebrewDMRIPSC::clock(unsigned int ms)
 	m_timeoutTimer.clock(ms);
 	if (m_timeoutTimer.isRunning() && m_timeoutTimer.hasExpired()) {
 		LogError("Connection to the master has timed out");
+		CFrameCapture::error("after the connection to the master timed out");
 		m_status = DISCONNECTED;
 		m_timeoutTimer.stop();
 		m_retryTimer.stop();
 	}
 }
 
+void CHomebrewDMRIPSC::processPacket(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port)
+{
+	assert(buffer != NULL);
+
+	if (m_debug)
+		CUtils::dump(1U, "IPSC Received", buffer, length);
+
+	if (length <= CAPTURE_MAX_DATA_LENGTH) {
+		if (length > 15U && ::memcmp(buffer, "DMRD", 4U) == 0)
+			CFrameCapture::add(CS_NETWORK, CD_RX, (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U, buffer[15U], buffer, length);
+		else
+			CFrameCapture::add(CS_NETWORK, CD_RX, 0U, 0x00U, buffer, length);
+	}
+
+	if (m_address.s_addr != address.s_addr || m_port != port)
+		return;
+
+	if (::memcmp(buffer, "DMRD", 4U) == 0) {
+		// The length is stored in a single byte, and nothing longer is valid anyway
+		if (length > HOMEBREW_DATA_PACKET_LENGTH) {
+			LogWarning("Oversized data packet received from the master, length %u", length);
+			return;
+		}
+
+		unsigned int space;
+		unsigned char* ptr = m_rxData.getWriteSpan(space);
+		if (space > (unsigned int)length) {
+			// Store the length and packet in one go
+			ptr[0U] = length;
+			::memcpy(ptr + 1U, buffer, length);
+			m_rxData.commitWrite(length + 1U);
+		} else if (m_rxData.hasSpace(length + 1U)) {
+			unsigned char len = length;
+			m_rxData.addData(&len, 1U);
+			m_rxData.addData(buffer, len);
+		} else {
+			LogWarning("No space to store data received from the master");
+		}
+	} else if (::memcmp(buffer, "MSTNAK",  6U) == 0) {
+		if (m_status == RUNNING) {
+			LogWarning("The master is restarting, logging back in");
+			m_status = WAITING_LOGIN;
+			m_timeoutTimer.start();
+			m_retryTimer.start();
+			m_pingTimer.stop();
+		} else {
+			LogError("Login to the master has failed");
+			CFrameCapture::error("after the login to the master failed");
+			m_status = DISCONNECTED;
+			m_timeoutTimer.stop();
+			m_retryTimer.stop();
+			m_pingTimer.stop();
+		}
+	} else if (::memcmp(buffer, "RPTACK",  6U) == 0) {
+		switch (m_status) {
+			case WAITING_LOGIN:
+				::memcpy(m_salt, buffer + 6U, sizeof(uint32_t));  
+				writeAuthorisation();
+				m_status = WAITING_AUTHORISATION;
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			case WAITING_AUTHORISATION:
+				writeConfig();
+				m_status = WAITING_CONFIG;
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			case WAITING_CONFIG:
+				LogMessage("Logged into the master succesfully");
+				m_status = RUNNING;
+				m_timeoutTimer.start();
+				m_retryTimer.stop();
+				m_pingTimer.start();
+				break;
+			default:
+				break;
+		}
+	} else if (::memcmp(buffer, "MSTCL",   5U) == 0) {
+		LogError("Master is closing down");
+		CFrameCapture::error("after the master closed down");
+		m_status = DISCONNECTED;		// XXX
+		m_timeoutTimer.stop();
+		m_retryTimer.stop();
+	} else if (::memcmp(buffer, "MSTPONG", 7U) == 0) {
+		m_timeoutTimer.start();
+	} else if (::memcmp(buffer, "RPTSBKN", 7U) == 0) {
+		m_beacon = true;
+	} else {
+		CUtils::dump("Unknown packet from the master", buffer, length);
+	}
+}
+
 bool CHomebrewDMRIPSC::writeLogin()
 {
 	unsigned char buffer[8U];
@@ -423,5 +506,28 @@ bool CHomebrewDMRIPSC::write(const unsigned char* data, unsigned int length)
 	if (m_debug)
 		CUtils::dump(1U, "IPSC Transmitted", data, length);
 
+	// The authorisation holds a hash of the password, so keep it out of the capture
+	if (::memcmp(data, "RPTK", 4U) != 0)
+		CFrameCapture::add(CS_NETWORK, CD_TX, 0U, 0x00U, data, length);
+
 	return m_socket.write(data, length, m_address, m_port);
 }
+
+bool CHomebrewDMRIPSC::write(const unsigned char* header, unsigned int headerLength, const unsigned char* data, unsigned int length)
+{
+	assert(header != NULL);
+	assert(data != NULL);
+	assert(headerLength + length <= HOMEBREW_DATA_PACKET_LENGTH);
+
+	if (m_debug) {
+		unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
+		::memcpy(buffer, header, headerLength);
+		::memcpy(buffer + headerLength, data, length);
+		CUtils::dump(1U, "IPSC Transmitted", buffer, headerLength + length);
+	}
+
+	// Only used for DMRD packets, the slot and frame type are in the header
+	CFrameCapture::add(CS_NETWORK, CD_TX, (header[15U] & 0x80U) == 0x80U ? 2U : 1U, header[15U], header, headerLength, data, length);
+
+	return m_socket.write(header, headerLength, data, length, m_address, m_port);
+}
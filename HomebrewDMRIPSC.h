@@ -45,6 +45,10 @@ public:
 
 	void clock(unsigned int ms);
 
+	int getFd() const;
+
+	void printStats();
+
 	void close();
 
 private: 
@@ -73,6 +77,8 @@ private:
 	unsigned char* m_salt;
 	uint32_t*      m_streamId;
 
+	unsigned char* m_rxBuffer;
+
 	CRingBuffer<unsigned char> m_rxData;
 
 	std::string    m_callsign;
@@ -89,12 +95,20 @@ private:
 
 	bool           m_beacon;
 
+	unsigned int   m_rxBatches;
+	unsigned int   m_rxPackets;
+	unsigned int   m_rxMaxBatch;
+	unsigned int   m_rxFullBatches;
+
+	void processPacket(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
+
 	bool writeLogin();
 	bool writeAuthorisation();
 	bool writeConfig();
 	bool writePing();
 
 	bool write(const unsigned char* data, unsigned int length);
+	bool write(const unsigned char* header, unsigned int headerLength, const unsigned char* data, unsigned int length);
 };
 
 #endif
@@ -27,6 +27,7 @@ CLC::CLC(FLCO flco, unsigned int srcId, unsigned int dstId) :
 m_PF(false),
 m_FLCO(flco),
 m_FID(0U),
+m_options(0U),
 m_srcId(srcId),
 m_dstId(dstId)
 {
@@ -36,6 +37,7 @@ CLC::CLC(const unsigned char* bytes) :
 m_PF(false),
 m_FLCO(FLCO_GROUP),
 m_FID(0U),
+m_options(0U),
 m_srcId(0U),
 m_dstId(0U)
 {
@@ -47,6 +49,8 @@ m_dstId(0U)
 
 	m_FID = bytes[1U];
 
+	m_options = bytes[2U];
+
 	m_dstId = bytes[3U] << 16 | bytes[4U] << 8 | bytes[5U];
 	m_srcId = bytes[6U] << 16 | bytes[7U] << 8 | bytes[8U];
 }
@@ -55,6 +59,7 @@ CLC::CLC(const bool* bits) :
 m_PF(false),
 m_FLCO(FLCO_GROUP),
 m_FID(0U),
+m_options(0U),
 m_srcId(0U),
 m_dstId(0U)
 {
@@ -69,6 +74,10 @@ m_dstId(0U)
 	CUtils::bitsToByteBE(bits + 8U, temp2);
 	m_FID = temp2;
 
+	unsigned char temp3;
+	CUtils::bitsToByteBE(bits + 16U, temp3);
+	m_options = temp3;
+
 	unsigned char d1, d2, d3;
 	CUtils::bitsToByteBE(bits + 24U, d1);
 	CUtils::bitsToByteBE(bits + 32U, d2);
@@ -87,6 +96,7 @@ CLC::CLC() :
 m_PF(false),
 m_FLCO(FLCO_GROUP),
 m_FID(0U),
+m_options(0U),
 m_srcId(0U),
 m_dstId(0U)
 {
@@ -107,6 +117,8 @@ void CLC::getData(unsigned char* bytes) const
 
 	bytes[1U] = m_FID;
 
+	bytes[2U] = m_options;
+
 	bytes[3U] = m_dstId >> 16;
 	bytes[4U] = m_dstId >> 8;
 	bytes[5U] = m_dstId >> 0;
@@ -52,6 +52,7 @@ private:
 	bool          m_PF;
 	FLCO          m_FLCO;
 	unsigned char m_FID;
+	unsigned char m_options;
 	unsigned int  m_srcId;
 	unsigned int  m_dstId;
 };
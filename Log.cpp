@@ -17,13 +17,40 @@
  */
 
 #include "Log.h"
+#include "MPSCQueue.h"
+
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cstdarg>
 #include <ctime>
 #include <cassert>
 
+// Long enough for a line of a hex dump, longer messages are truncated
+const unsigned int LOG_TEXT_LENGTH = 256U;
+
+// The number of messages that may wait for the writer thread, any more are dropped and counted
+const unsigned int LOG_QUEUE_LENGTH = 512U;
+
+// "YYYY-MM-DD HH:MM:SS"
+const unsigned int LOG_STAMP_LENGTH = 19U;
+
+const time_t LOG_DAY_SECONDS = 86400;
+
+// A message formatted and timed by the thread that logged it
+struct LOG_RECORD {
+	unsigned int m_level;
+	time_t       m_time;
+	unsigned int m_length;
+	char         m_text[LOG_TEXT_LENGTH];
+};
+
 static std::string m_path;
 static std::string m_root;
 
@@ -33,25 +60,48 @@ static bool m_display = true;
 
 static unsigned int m_level = 2U;
 
-static struct tm m_tm;
+static time_t m_rollover = 0;
+
+// The line being written, the level, date and time prefix is kept between lines
+static char   m_line[LOG_STAMP_LENGTH + LOG_TEXT_LENGTH + 5U];
+static time_t m_stampTime = (time_t)-1;
 
 static char LEVELS[] = " DMIWEF";
 
-static bool LogOpen()
+static CMPSCQueue<LOG_RECORD>* m_queue = NULL;
+
+static std::atomic<unsigned int> m_dropped(0U);
+
+// The writer thread waits on m_cond, m_running is protected by m_mutex
+static std::thread*            m_thread = NULL;
+static std::mutex              m_mutex;
+static std::condition_variable m_cond;
+static bool                    m_running = false;
+
+// Returns the length of the text, after any truncation
+static unsigned int LogFormat(char* text, const char* fmt, va_list vl)
 {
-	time_t now;
-	::time(&now);
+	int n = ::vsnprintf(text, LOG_TEXT_LENGTH, fmt, vl);
+	if (n < 0) {
+		text[0U] = '\0';
+		return 0U;
+	}
 
-	struct tm* tm = ::gmtime(&now);
+	return (unsigned int)n < LOG_TEXT_LENGTH ? (unsigned int)n : LOG_TEXT_LENGTH - 1U;
+}
+
+static bool LogOpen(time_t now)
+{
+	if (m_fpLog != NULL) {
+		// Also catch the clock being set back past the start of the day
+		if (now < m_rollover && now >= m_rollover - LOG_DAY_SECONDS)
+			return true;
 
-	if (tm->tm_mday == m_tm.tm_mday && tm->tm_mon == m_tm.tm_mon && tm->tm_year == m_tm.tm_year) {
-		if (m_fpLog != NULL)
-		    return true;
-	} else {
-		if (m_fpLog != NULL)
-			::fclose(m_fpLog);
+		::fclose(m_fpLog);
 	}
 
+	struct tm* tm = ::gmtime(&now);
+
 	char filename[50U];
 #if defined(_WIN32) || defined(_WIN64)
 	::sprintf(filename, "%s\\%s-%04d-%02d-%02d.log", m_path.c_str(), m_root.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
@@ -60,23 +110,146 @@ static bool LogOpen()
 #endif
 
 	m_fpLog = ::fopen(filename, "a+t");
-	m_tm = *tm;
+
+	// The next UTC midnight, a time_t doesn't count leap seconds so every day has the same length
+	m_rollover = now - now % LOG_DAY_SECONDS + LOG_DAY_SECONDS;
 
     return m_fpLog != NULL;
 }
 
+// Only called by the writer thread, or once it has stopped
+static void LogWrite(const LOG_RECORD& record)
+{
+	bool ret = ::LogOpen(record.m_time);
+	if (!ret)
+		return;
+
+	// The line is "L: YYYY-MM-DD HH:MM:SS text", the date and time only change once a second
+	if (record.m_time != m_stampTime) {
+		struct tm* tm = ::gmtime(&record.m_time);
+
+		char stamp[80U];
+		::sprintf(stamp, "%04d-%02d-%02d %02d:%02d:%02d", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec);
+
+		m_line[1U] = ':';
+		m_line[2U] = ' ';
+		::memcpy(m_line + 3U, stamp, LOG_STAMP_LENGTH);
+		m_line[LOG_STAMP_LENGTH + 3U] = ' ';
+
+		m_stampTime = record.m_time;
+	}
+
+	m_line[0U] = LEVELS[record.m_level];
+
+	unsigned int length = LOG_STAMP_LENGTH + 4U;
+	::memcpy(m_line + length, record.m_text, record.m_length);
+	length += record.m_length;
+	m_line[length++] = '\n';
+
+	::fwrite(m_line, 1U, length, m_fpLog);
+	if (m_display)
+		::fwrite(m_line, 1U, length, stdout);
+}
+
+// Write everything waiting and flush once at the end
+static void LogDrain()
+{
+	bool written = false;
+
+	LOG_RECORD record;
+	while (m_queue->get(record)) {
+		::LogWrite(record);
+		written = true;
+	}
+
+	unsigned int dropped = m_dropped.exchange(0U);
+	if (dropped > 0U) {
+		record.m_level = 4U;
+		::time(&record.m_time);
+		::snprintf(record.m_text, LOG_TEXT_LENGTH, "The log queue was full, %u messages have been dropped", dropped);
+		record.m_length = (unsigned int)::strlen(record.m_text);
+
+		::LogWrite(record);
+		written = true;
+	}
+
+	if (!written)
+		return;
+
+	if (m_fpLog != NULL)
+		::fflush(m_fpLog);
+
+	if (m_display)
+		::fflush(stdout);
+}
+
+static void LogWriter()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (m_running) {
+		lock.unlock();
+		::LogDrain();
+		lock.lock();
+
+		// Loggers don't take the lock so a wakeup may be missed, the timeout limits the delay
+		if (m_running && m_queue->isEmpty())
+			m_cond.wait_for(lock, std::chrono::seconds(1));
+	}
+
+	lock.unlock();
+	::LogDrain();
+}
+
 bool LogInitialise(const std::string& path, const std::string& root, bool display)
 {
 	m_path    = path;
 	m_root    = root;
 	m_display = display;
-    return ::LogOpen();
+
+	time_t now;
+	::time(&now);
+
+	bool ret = ::LogOpen(now);
+	if (!ret)
+		return false;
+
+	m_queue = new CMPSCQueue<LOG_RECORD>(LOG_QUEUE_LENGTH);
+
+	m_running = true;
+	m_thread  = new std::thread(LogWriter);
+
+	return true;
+}
+
+// Everything queued so far is written before the writer thread exits
+static void LogStop()
+{
+	if (m_thread != NULL) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+
+		m_cond.notify_one();
+
+		m_thread->join();
+		delete m_thread;
+		m_thread = NULL;
+	}
 }
 
 void LogFinalise()
 {
-    if (m_fpLog != NULL)
-        ::fclose(m_fpLog);
+	::LogStop();
+
+	delete m_queue;
+	m_queue = NULL;
+
+	if (m_fpLog != NULL) {
+		::fclose(m_fpLog);
+		m_fpLog = NULL;
+	}
 }
 
 void LogSetLevel(unsigned int level)
@@ -84,44 +257,38 @@ void LogSetLevel(unsigned int level)
     m_level = level;
 }
 
+bool LogIsEnabled(unsigned int level)
+{
+    return level >= m_level && m_queue != NULL;
+}
+
+// Never blocks, the message is formatted here and written by the writer thread, apart from a fatal one
 void Log(unsigned int level, const char* fmt, ...)
 {
     assert(level < 7U);
     assert(fmt != NULL);
 
-    if (level < m_level)
-        return;
-
-    bool ret = ::LogOpen();
-    if (!ret)
+    if (level < m_level || m_queue == NULL)
         return;
 
-    time_t now;
-    ::time(&now);
-
-    struct tm* tm = ::gmtime(&now);
-
-    ::fprintf(m_fpLog, "%c: %04d-%02d-%02d %02d:%02d:%02d ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec);
-	if (m_display)
-	    ::fprintf(stdout, "%c: %04d-%02d-%02d %02d:%02d:%02d ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec);
+    LOG_RECORD record;
+    record.m_level = level;
+    ::time(&record.m_time);
 
     va_list vl;
     va_start(vl, fmt);
-    vfprintf(m_fpLog, fmt, vl);
-	if (m_display)
-	    vfprintf(stdout, fmt, vl);
+    record.m_length = ::LogFormat(record.m_text, fmt, vl);
     va_end(vl);
 
-    ::fprintf(m_fpLog, "\n");
-    ::fflush(m_fpLog);
-
-	if (m_display) {
-	    ::fprintf(stdout, "\n");
-		::fflush(stdout);
-	}
-
-    if (level == 6U) {		// Fatal
-        ::fclose(m_fpLog);
+    if (level == 6U) {		// Fatal, written directly after what is queued so that it can't be dropped
+        ::LogStop();
+        ::LogWrite(record);
+        ::LogFinalise();
         exit(1);
     }
+
+    if (m_queue->add(record))
+        m_cond.notify_one();
+    else
+        m_dropped++;
 }
@@ -35,4 +35,7 @@ extern void LogFinalise();
 
 extern void LogSetLevel(unsigned int level);
 
+// Whether a message at this level would be logged, for callers with output that is costly to build
+extern bool LogIsEnabled(unsigned int level);
+
 #endif
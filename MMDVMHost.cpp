@@ -20,6 +20,8 @@
 #include "Log.h"
 #include "Version.h"
 #include "StopWatch.h"
+#include "EventLoop.h"
+#include "FrameCapture.h"
 #include "Defines.h"
 #include "DMRControl.h"
 #include "TFTSerial.h"
@@ -35,13 +37,24 @@
 #include <signal.h>
 #endif
 
+// The main loop runs on a 5ms tick when a mode is active, when idle it only wakes
+// for modem or network traffic, or to clock the timers
+const unsigned int ACTIVE_TICK_MS  = 5U;
+const unsigned int IDLE_TIMEOUT_MS = 100U;
+
 static bool m_killed = false;
+static bool m_capture = false;
 
 #if !defined(_WIN32) && !defined(_WIN64)
 static void sigHandler(int)
 {
   m_killed = true;
 }
+
+static void sigCapture(int)
+{
+  m_capture = true;
+}
 #endif
 
 const char* HEADER1 = "This software is for use on amateur radio networks only.";
@@ -57,6 +70,7 @@ int main(int argc, char** argv)
 
 #if !defined(_WIN32) && !defined(_WIN64)
   ::signal(SIGUSR1, sigHandler);
+  ::signal(SIGUSR2, sigCapture);
 #endif
 
   CMMDVMHost* host = new CMMDVMHost(std::string(argv[1]));
@@ -108,6 +122,16 @@ int CMMDVMHost::run()
 
 	readParams();
 
+	if (m_conf.getCaptureEnabled()) {
+		unsigned int minutes = m_conf.getCaptureMinutes();
+
+		LogInfo("Capture Parameters");
+		LogInfo("    Minutes: %u", minutes);
+
+		if (minutes > 0U)
+			CFrameCapture::open(m_conf.getLogPath(), m_conf.getLogRoot(), minutes);
+	}
+
 	ret = createModem();
 	if (!ret)
 		return 1;
@@ -120,9 +144,21 @@ int CMMDVMHost::run()
 			return 1;
 	}
 
+	CEventLoop eventLoop;
+	ret = eventLoop.open();
+	if (!ret)
+		return 1;
+
+	eventLoop.addFd(m_modem->getFd());
+	if (m_dmrNetwork != NULL)
+		eventLoop.addFd(m_dmrNetwork->getFd());
+
 	CTimer dmrBeaconTimer(1000U, 4U);
 	bool dmrBeaconsEnabled = m_dmrEnabled && m_conf.getDMRBeacons();
 
+	CTimer statsTimer(1000U, 60U);
+	statsTimer.start();
+
 	CStopWatch stopWatch;
 	stopWatch.start();
 
@@ -130,18 +166,42 @@ int CMMDVMHost::run()
 	if (m_dstarEnabled)
 		dstar = new CDStarEcho(2U, 10000U);
 
+	CDMRRecorder* recorder = NULL;
+	if (m_dmrEnabled && m_conf.getDMRRecorderEnabled()) {
+		std::string path                     = m_conf.getDMRRecorderPath();
+		bool slot1                           = m_conf.getDMRRecorderSlot1();
+		bool slot2                           = m_conf.getDMRRecorderSlot2();
+		std::vector<unsigned int> talkGroups = m_conf.getDMRRecorderTalkGroups();
+
+		LogInfo("DMR Recorder Parameters");
+		LogInfo("    Path: %s", path.c_str());
+		LogInfo("    Slot 1: %s", slot1 ? "yes" : "no");
+		LogInfo("    Slot 2: %s", slot2 ? "yes" : "no");
+		if (talkGroups.empty()) {
+			LogInfo("    Talk Groups: all");
+		} else {
+			for (std::vector<unsigned int>::const_iterator it = talkGroups.begin(); it != talkGroups.end(); ++it)
+				LogInfo("    Talk Group: %u", *it);
+		}
+
+		recorder = new CDMRRecorder(path, slot1, slot2, talkGroups);
+		recorder->open();
+	}
+
 	CDMRControl* dmr = NULL;
 	if (m_dmrEnabled) {
 		unsigned int id        = m_conf.getDMRId();
 		unsigned int colorCode = m_conf.getDMRColorCode();
 		unsigned int timeout   = m_conf.getTimeout();
+		bool debug             = m_conf.getDMRDebug();
 
 		LogInfo("DMR Parameters");
 		LogInfo("    Id: %u", id);
 		LogInfo("    Color Code: %u", colorCode);
 		LogInfo("    Timeout: %us", timeout);
+		LogInfo("    Debug: %s", debug ? "yes" : "no");
 
-		dmr = new CDMRControl(id, colorCode, timeout, m_modem, m_dmrNetwork, m_display);
+		dmr = new CDMRControl(id, colorCode, timeout, m_modem, m_dmrNetwork, m_display, recorder, debug);
 	}
 
 	CYSFEcho* ysf = NULL;
@@ -155,9 +215,52 @@ int CMMDVMHost::run()
 
 	while (!m_killed) {
 		unsigned char data[200U];
+		CDMRFrame dmrFrame;
 		unsigned int len;
 		bool ret;
 
+		// Don't block if the modem has bytes that it hasn't parsed yet, or frames that haven't been handled
+		eventLoop.wait(m_modem->hasBufferedData() ? 0U : IDLE_TIMEOUT_MS);
+
+		unsigned int ms = stopWatch.elapsed();
+		stopWatch.start();
+
+		m_modem->clock(ms);
+		modeTimer.clock(ms);
+		if (dstar != NULL)
+			dstar->clock(ms);
+		if (dmr != NULL)
+			dmr->clock(ms);
+		if (ysf != NULL)
+			ysf->clock(ms);
+
+		if (m_capture) {
+			CFrameCapture::request("on request");
+			m_capture = false;
+		}
+
+		CFrameCapture::clock(ms);
+
+		dmrBeaconTimer.clock(ms);
+		if (dmrBeaconTimer.isRunning() && dmrBeaconTimer.hasExpired()) {
+			dmrBeaconTimer.stop();
+			m_modem->writeDMRStart(false);
+			mode = MODE_IDLE;
+		}
+
+		statsTimer.clock(ms);
+		if (statsTimer.hasExpired()) {
+			LogDebug("Main loop wakeups in the last 60s, I/O: %u, tick: %u, timeout: %u", eventLoop.getIOWakeups(), eventLoop.getTickWakeups(), eventLoop.getTimeouts());
+			eventLoop.resetStats();
+			m_modem->printStats();
+			CDMRFrame::printStats();
+			if (m_dmrNetwork != NULL)
+				m_dmrNetwork->printStats();
+			if (dmr != NULL)
+				dmr->printStats();
+			statsTimer.start();
+		}
+
 		len = m_modem->readDStarData(data);
 		if (dstar != NULL && len > 0U) {
 			if (mode == MODE_IDLE && (data[0U] == TAG_HEADER || data[0U] == TAG_DATA)) {
@@ -177,10 +280,10 @@ int CMMDVMHost::run()
 			}
 		}
 
-		len = m_modem->readDMRData1(data);
-		if (dmr != NULL && len > 0U) {
+		ret = m_modem->readDMRData1(dmrFrame);
+		if (dmr != NULL && ret) {
 			if (mode == MODE_IDLE) {
-				bool ret = dmr->processWakeup(data);
+				bool ret = dmr->processWakeup(dmrFrame.getData());
 				if (ret) {
 					LogMessage("Mode set to DMR");
 					mode = MODE_DMR;
@@ -190,7 +293,7 @@ int CMMDVMHost::run()
 					modeTimer.start();
 				}
 			} else if (mode == MODE_DMR) {
-				dmr->writeModemSlot1(data);
+				dmr->writeModemSlot1(dmrFrame);
 				dmrBeaconTimer.stop();
 				modeTimer.start();
 			} else {
@@ -198,10 +301,10 @@ int CMMDVMHost::run()
 			}
 		}
 
-		len = m_modem->readDMRData2(data);
-		if (dmr != NULL && len > 0U) {
+		ret = m_modem->readDMRData2(dmrFrame);
+		if (dmr != NULL && ret) {
 			if (mode == MODE_IDLE) {
-				bool ret = dmr->processWakeup(data);
+				bool ret = dmr->processWakeup(dmrFrame.getData());
 				if (ret) {
 					LogMessage("Mode set to DMR");
 					mode = MODE_DMR;
@@ -211,7 +314,7 @@ int CMMDVMHost::run()
 					modeTimer.start();
 				}
 			} else if (mode == MODE_DMR) {
-				dmr->writeModemSlot2(data);
+				dmr->writeModemSlot2(dmrFrame);
 				dmrBeaconTimer.stop();
 				modeTimer.start();
 			} else {
@@ -323,37 +426,15 @@ int CMMDVMHost::run()
 			}
 		}
 
-		unsigned int ms = stopWatch.elapsed();
-		m_modem->clock(ms);
-		modeTimer.clock(ms);
-		if (dstar != NULL)
-			dstar->clock(ms);
-		if (dmr != NULL)
-			dmr->clock(ms);
-		if (ysf != NULL)
-			ysf->clock(ms);
-		stopWatch.start();
-
-		dmrBeaconTimer.clock(ms);
-		if (dmrBeaconTimer.isRunning() && dmrBeaconTimer.hasExpired()) {
-			dmrBeaconTimer.stop();
-			m_modem->writeDMRStart(false);
-			mode = MODE_IDLE;
-		}
-
-		if (ms < 5U) {
-#if defined(_WIN32) || defined(_WIN64)
-			::Sleep(5UL);		// 5ms
-#else
-			::usleep(5000);		// 5ms
-#endif
-		}
+		eventLoop.setTick(mode != MODE_IDLE ? ACTIVE_TICK_MS : 0U);
 	}
 
 	LogMessage("MMDVMHost is exiting on receipt of SIGHUP1");
 
 	m_display->setIdle();
 
+	eventLoop.close();
+
 	m_modem->close();
 	delete m_modem;
 
@@ -369,6 +450,13 @@ int CMMDVMHost::run()
 	delete dmr;
 	delete ysf;
 
+	if (recorder != NULL) {
+		recorder->close();
+		delete recorder;
+	}
+
+	CFrameCapture::close();
+
 	return 0;
 }
 
@@ -382,6 +470,7 @@ bool CMMDVMHost::createModem()
     unsigned int rxLevel   = m_conf.getModemRXLevel();
     unsigned int txLevel   = m_conf.getModemTXLevel();
     bool debug             = m_conf.getModemDebug();
+	unsigned int frames    = m_conf.getModemFramesPerTick();
 	unsigned int colorCode = m_conf.getDMRColorCode();
 
 	LogInfo("Modem Parameters");
@@ -392,10 +481,12 @@ bool CMMDVMHost::createModem()
 	LogInfo("    TX Delay: %u", txDelay);
 	LogInfo("    RX Level: %u", rxLevel);
 	LogInfo("    TX Level: %u", txLevel);
+	LogInfo("    Frames Per Tick: %u", frames);
 
 	m_modem = new CModem(port, rxInvert, txInvert, pttInvert, txDelay, rxLevel, txLevel, debug);
 	m_modem->setModeParams(m_dstarEnabled, m_dmrEnabled, m_ysfEnabled);
 	m_modem->setDMRParams(colorCode);
+	m_modem->setFramesPerTick(frames);
 
 	bool ret = m_modem->open();
 	if (!ret) {
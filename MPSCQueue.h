@@ -0,0 +1,132 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef MPSCQueue_H
+#define MPSCQueue_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+const unsigned int MPSC_CACHE_LINE = 64U;
+
+// A bounded queue of items passed from any number of producer threads to
+// exactly one consumer thread without locks. Each slot carries a sequence
+// number that says whether it is free for the producer that claims it, or
+// holds an item ready for the consumer. Producers claim slots by advancing
+// the write position with a compare and swap, and a full queue makes add()
+// fail rather than wait.
+template<class T> class CMPSCQueue {
+public:
+	// The length must be a power of two
+	CMPSCQueue(unsigned int length) :
+	m_mask(length - 1U),
+	m_slots(NULL),
+	m_iPtr(0U),
+	m_oPtr(0U)
+	{
+		assert(length > 1U);
+		assert((length & (length - 1U)) == 0U);
+
+		m_slots = new SLOT[length];
+
+		for (unsigned int i = 0U; i < length; i++)
+			m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~CMPSCQueue()
+	{
+		delete[] m_slots;
+	}
+
+	// Producer side, any thread
+
+	bool add(const T& item)
+	{
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+
+		for (;;) {
+			SLOT& slot = m_slots[iPtr & m_mask];
+
+			unsigned int sequence = slot.m_sequence.load(std::memory_order_acquire);
+			int diff = int(sequence - iPtr);
+
+			if (diff == 0) {
+				// The slot is free, try to claim it
+				if (m_iPtr.compare_exchange_weak(iPtr, iPtr + 1U, std::memory_order_relaxed)) {
+					slot.m_item = item;
+					slot.m_sequence.store(iPtr + 1U, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				// The consumer hasn't finished with this slot yet, the queue is full
+				return false;
+			} else {
+				// Another producer claimed the slot first
+				iPtr = m_iPtr.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Consumer side, one thread only
+
+	bool get(T& item)
+	{
+		SLOT& slot = m_slots[m_oPtr & m_mask];
+
+		unsigned int sequence = slot.m_sequence.load(std::memory_order_acquire);
+		if (sequence != m_oPtr + 1U)
+			return false;
+
+		item = slot.m_item;
+
+		// Free the slot for the producers on the next lap
+		slot.m_sequence.store(m_oPtr + m_mask + 1U, std::memory_order_release);
+		m_oPtr++;
+
+		return true;
+	}
+
+	bool isEmpty() const
+	{
+		return m_slots[m_oPtr & m_mask].m_sequence.load(std::memory_order_acquire) != m_oPtr + 1U;
+	}
+
+private:
+	struct SLOT {
+		std::atomic<unsigned int> m_sequence;
+		T                         m_item;
+	};
+
+	unsigned int              m_mask;
+	SLOT*                     m_slots;
+	char                      m_pad0[MPSC_CACHE_LINE];
+
+	// Written by the producers
+	std::atomic<unsigned int> m_iPtr;
+	char                      m_pad1[MPSC_CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+
+	// Written by the consumer
+	unsigned int              m_oPtr;
+	char                      m_pad2[MPSC_CACHE_LINE - sizeof(unsigned int)];
+
+	CMPSCQueue(const CMPSCQueue&);
+	CMPSCQueue& operator=(const CMPSCQueue&);
+};
+
+#endif
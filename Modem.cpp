@@ -22,6 +22,7 @@
 #include "Defines.h"
 #include "Modem.h"
 #include "Utils.h"
+#include "FrameCapture.h"
 #include "Log.h"
 
 #include <cmath>
@@ -71,6 +72,30 @@ const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 500U;
 
+const unsigned int MAX_FRAME_LENGTH = 200U;
+
+const unsigned int READ_LENGTH = 256U;
+
+const unsigned int DEFAULT_FRAMES_PER_TICK = 10U;
+
+// The same capacity as the old 1000 byte rings of framed MMDVM commands
+const unsigned int DMR_RX_QUEUE_FRAMES = 27U;
+const unsigned int DMR_TX_QUEUE_FRAMES = 25U;
+
+// The DMR slot of a frame type, 0 for the other modes
+static unsigned int getSlot(unsigned char type)
+{
+	switch (type) {
+		case MMDVM_DMR_DATA1:
+		case MMDVM_DMR_LOST1:
+			return 1U;
+		case MMDVM_DMR_DATA2:
+		case MMDVM_DMR_LOST2:
+			return 2U;
+		default:
+			return 0U;
+	}
+}
 
 CModem::CModem(const std::string& port, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel, bool debug) :
 m_port(port),
@@ -87,12 +112,20 @@ m_dmrEnabled(false),
 m_ysfEnabled(false),
 m_serial(port, SERIAL_115200, true),
 m_buffer(NULL),
+m_txBuffer(NULL),
+m_readBuffer(NULL),
+m_readPtr(0U),
+m_readLength(0U),
+m_rxState(SS_START),
+m_rxOffset(0U),
+m_rxLength(0U),
+m_rxDiscarded(0U),
 m_rxDStarData(1000U),
 m_txDStarData(1000U),
-m_rxDMRData1(1000U),
-m_rxDMRData2(1000U),
-m_txDMRData1(1000U),
-m_txDMRData2(1000U),
+m_rxDMRData1(DMR_RX_QUEUE_FRAMES),
+m_rxDMRData2(DMR_RX_QUEUE_FRAMES),
+m_txDMRData1(DMR_TX_QUEUE_FRAMES),
+m_txDMRData2(DMR_TX_QUEUE_FRAMES),
 m_rxYSFData(1000U),
 m_txYSFData(1000U),
 m_statusTimer(1000U, 0U, 100U),
@@ -100,16 +133,27 @@ m_dstarSpace(0U),
 m_dmrSpace1(0U),
 m_dmrSpace2(0U),
 m_ysfSpace(0U),
-m_tx(false)
+m_tx(false),
+m_framesPerTick(DEFAULT_FRAMES_PER_TICK),
+m_rxFrames(0U),
+m_rxTicks(0U),
+m_rxMaxFrames(0U),
+m_rxBudgetHits(0U),
+m_txDMRMaxDepth1(0U),
+m_txDMRMaxDepth2(0U)
 {
 	assert(!port.empty());
 
-	m_buffer = new unsigned char[BUFFER_LENGTH];
+	m_buffer     = new unsigned char[BUFFER_LENGTH];
+	m_txBuffer   = new unsigned char[BUFFER_LENGTH];
+	m_readBuffer = new unsigned char[READ_LENGTH];
 }
 
 CModem::~CModem()
 {
 	delete[] m_buffer;
+	delete[] m_txBuffer;
+	delete[] m_readBuffer;
 }
 
 void CModem::setModeParams(bool dstarEnabled, bool dmrEnabled, bool ysfEnabled)
@@ -126,6 +170,13 @@ void CModem::setDMRParams(unsigned int colorCode)
 	m_colorCode = colorCode;
 }
 
+void CModem::setFramesPerTick(unsigned int frames)
+{
+	assert(frames > 0U);
+
+	m_framesPerTick = frames;
+}
+
 bool CModem::open()
 {
 	::LogMessage("Opening the MMDVM");
@@ -160,207 +211,35 @@ void CModem::clock(unsigned int ms)
 		m_statusTimer.start();
 	}
 
-	unsigned int length;
-	RESP_TYPE_MMDVM type = getResponse(m_buffer, length);
-
-	if (type == RTM_TIMEOUT) {
-		// Nothing to do
-	} else if (type == RTM_ERROR) {
-		LogError("Error when reading from the MMDVM");
-	} else {
-		// type == RTM_OK
-		switch (m_buffer[2U]) {
-			case MMDVM_DSTAR_HEADER: {
-					if (m_debug)
-						CUtils::dump(1U, "RX D-Star Header", m_buffer, length);
-
-					unsigned char data = length - 2U;
-					m_rxDStarData.addData(&data, 1U);
-
-					data = TAG_HEADER;
-					m_rxDStarData.addData(&data, 1U);
-
-					m_rxDStarData.addData(m_buffer + 3U, length - 3U);
-				}
-				break;
-
-			case MMDVM_DSTAR_DATA: {
-					if (m_debug)
-						CUtils::dump(1U, "RX D-Star Data", m_buffer, length);
-
-					unsigned char data = length - 2U;
-					m_rxDStarData.addData(&data, 1U);
-
-					data = TAG_DATA;
-					m_rxDStarData.addData(&data, 1U);
-
-					m_rxDStarData.addData(m_buffer + 3U, length - 3U);
-				}
-				break;
-
-			case MMDVM_DSTAR_LOST: {
-					if (m_debug)
-						CUtils::dump(1U, "RX D-Star Lost", m_buffer, length);
-
-					unsigned char data = 1U;
-					m_rxDStarData.addData(&data, 1U);
-
-					data = TAG_LOST;
-					m_rxDStarData.addData(&data, 1U);
-				}
-				break;
-
-			case MMDVM_DSTAR_EOT: {
-					if (m_debug)
-						CUtils::dump(1U, "RX D-Star EOT", m_buffer, length);
-
-					unsigned char data = 1U;
-					m_rxDStarData.addData(&data, 1U);
-
-					data = TAG_EOT;
-					m_rxDStarData.addData(&data, 1U);
-				}
-				break;
-
-			case MMDVM_DMR_DATA1: {
-					if (m_debug)
-						CUtils::dump(1U, "RX DMR Data 1", m_buffer, length);
-
-					unsigned char data = length - 2U;
-					m_rxDMRData1.addData(&data, 1U);
-
-					if (m_buffer[3U] == (DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC))
-						data = TAG_EOT;
-					else
-						data = TAG_DATA;
-					m_rxDMRData1.addData(&data, 1U);
-
-					m_rxDMRData1.addData(m_buffer + 3U, length - 3U);
-				}
-				break;
-
-			case MMDVM_DMR_DATA2: {
-					if (m_debug)
-						CUtils::dump(1U, "RX DMR Data 2", m_buffer, length);
-
-					unsigned char data = length - 2U;
-					m_rxDMRData2.addData(&data, 1U);
-
-					if (m_buffer[3U] == (DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC))
-						data = TAG_EOT;
-					else
-						data = TAG_DATA;
-					m_rxDMRData2.addData(&data, 1U);
-
-					m_rxDMRData2.addData(m_buffer + 3U, length - 3U);
-				}
-				break;
-
-			case MMDVM_DMR_LOST1: {
-					if (m_debug)
-						CUtils::dump(1U, "RX DMR Lost 1", m_buffer, length);
-
-					unsigned char data = 1U;
-					m_rxDMRData1.addData(&data, 1U);
-
-					data = TAG_LOST;
-					m_rxDMRData1.addData(&data, 1U);
-				}
-				break;
-
-			case MMDVM_DMR_LOST2: {
-					if (m_debug)
-						CUtils::dump(1U, "RX DMR Lost 2", m_buffer, length);
-
-					unsigned char data = 1U;
-					m_rxDMRData2.addData(&data, 1U);
-
-					data = TAG_LOST;
-					m_rxDMRData2.addData(&data, 1U);
-				}
-				break;
-
-			case MMDVM_YSF_DATA: {
-					if (m_debug)
-						CUtils::dump(1U, "RX YSF Data", m_buffer, length);
+	// Handle every complete frame that is waiting, up to the per tick budget
+	unsigned int frames = 0U;
+	while (frames < m_framesPerTick) {
+		unsigned int length;
+		RESP_TYPE_MMDVM type = getResponse(length);
 
-					unsigned char data = length - 2U;
-					m_rxYSFData.addData(&data, 1U);
+		if (type == RTM_TIMEOUT)
+			break;
 
-					if ((m_buffer[3U] & (YSF_CKSUM_OK | YSF_FI_MASK)) == (YSF_CKSUM_OK | YSF_DT_TERMINATOR_CHANNEL))
-						data = TAG_EOT;
-					else
-						data = TAG_DATA;
-					m_rxYSFData.addData(&data, 1U);
-
-					m_rxYSFData.addData(m_buffer + 3U, length - 3U);
-				}
-				break;
-
-			case MMDVM_YSF_LOST: {
-					if (m_debug)
-						CUtils::dump(1U, "RX YSF Lost", m_buffer, length);
-
-					unsigned char data = 1U;
-					m_rxYSFData.addData(&data, 1U);
-
-					data = TAG_LOST;
-					m_rxYSFData.addData(&data, 1U);
-				}
-				break;
-
-			case MMDVM_GET_STATUS: {
-					// if (m_debug)
-					//	CUtils::dump(1U, "GET_STATUS", m_buffer, length);
-
-					m_tx = (m_buffer[5U] & 0x01U) == 0x01U;
-
-					bool adcOverflow = (m_buffer[5U] & 0x02U) == 0x02U;
-					if (adcOverflow)
-						LogError("MMDVM ADC levels have overflowed");
-
-					bool rxOverflow = (m_buffer[5U] & 0x04U) == 0x04U;
-					if (rxOverflow)
-						LogError("MMDVM RX buffer has overflowed");
-
-					bool txOverflow = (m_buffer[5U] & 0x08U) == 0x08U;
-					if (txOverflow)
-						LogError("MMDVM TX buffer has overflowed");
-
-					m_dstarSpace = m_buffer[6U];
-					m_dmrSpace1  = m_buffer[7U];
-					m_dmrSpace2  = m_buffer[8U];
-					m_ysfSpace   = m_buffer[9U];
-					// LogMessage("status=%02X, tx=%d, space=%u,%u,%u,%u", m_buffer[5U], int(m_tx), m_dstarSpace, m_dmrSpace1, m_dmrSpace2, m_ysfSpace);
-				}
-				break;
-
-			// These should not be received, but don't complain if we do
-			case MMDVM_GET_VERSION:
-			case MMDVM_ACK:
-				break;
+		if (type == RTM_ERROR) {
+			LogError("Error when reading from the MMDVM");
+			CFrameCapture::error("after an error reading from the MMDVM");
+			break;
+		}
 
-			case MMDVM_NAK:
-				LogWarning("Received a NAK from the MMDVM, command = 0x%02X, reason = %u", m_buffer[3U], m_buffer[4U]);
-				break;
+		// type == RTM_OK
+		processResponse(length);
+		frames++;
+	}
 
-			case MMDVM_DEBUG1:
-			case MMDVM_DEBUG2:
-			case MMDVM_DEBUG3:
-			case MMDVM_DEBUG4:
-			case MMDVM_DEBUG5:
-				printDebug();
-				break;
+	if (frames > 0U) {
+		m_rxFrames += frames;
+		m_rxTicks++;
 
-			case MMDVM_SAMPLES:
-				// printSamples();
-				break;
+		if (frames > m_rxMaxFrames)
+			m_rxMaxFrames = frames;
 
-			default:
-				LogMessage("Unknown message, type: %02X", m_buffer[2U]);
-				CUtils::dump("Buffer dump", m_buffer, length);
-				break;
-		}
+		if (frames == m_framesPerTick)
+			m_rxBudgetHits++;
 	}
 
 	if (m_dstarSpace > 1U && !m_txDStarData.isEmpty()) {
@@ -372,57 +251,45 @@ void CModem::clock(unsigned int ms)
 			(buffer[1U] == TAG_EOT    && m_dstarSpace > 1U)) {
 			unsigned char len = 0U;
 			m_txDStarData.getData(&len, 1U);
-			m_txDStarData.getData(m_buffer, len);
+			m_txDStarData.getData(m_txBuffer, len);
 
 			if (m_debug) {
 				switch (buffer[1U]) {
 				case TAG_HEADER:
-					CUtils::dump(1U, "TX D-Star Header", m_buffer, len);
+					CUtils::dump(1U, "TX D-Star Header", m_txBuffer, len);
 					m_dstarSpace -= 4U;
 					break;
 				case TAG_DATA:
-					CUtils::dump(1U, "TX D-Star Data", m_buffer, len);
+					CUtils::dump(1U, "TX D-Star Data", m_txBuffer, len);
 					m_dstarSpace -= 1U;
 					break;
 				default:
-					CUtils::dump(1U, "TX D-Star EOT", m_buffer, len);
+					CUtils::dump(1U, "TX D-Star EOT", m_txBuffer, len);
 					m_dstarSpace -= 1U;
 					break;
 				}
 			}
 
-			int ret = m_serial.write(m_buffer, len);
-			if (ret != int(len))
+			CFrameCapture::add(CS_MODEM, CD_TX, 0U, m_txBuffer[2U], m_txBuffer, len);
+
+			int ret = m_serial.write(m_txBuffer, len);
+			if (ret != int(len)) {
 				LogWarning("Error when writing D-Star data to the MMDVM");
+				CFrameCapture::error("after an error writing to the MMDVM");
+			}
 		}
 	}
 
 	if (m_dmrSpace1 > 1U && !m_txDMRData1.isEmpty()) {
-		unsigned char len = 0U;
-		m_txDMRData1.getData(&len, 1U);
-		m_txDMRData1.getData(m_buffer, len);
-
-		if (m_debug)
-			CUtils::dump(1U, "TX DMR Data 1", m_buffer, len);
-
-		int ret = m_serial.write(m_buffer, len);
-		if (ret != int(len))
-			LogWarning("Error when writing DMR data to the MMDVM");
+		writeDMRFrame(m_txDMRData1.peek(), MMDVM_DMR_DATA1);
+		m_txDMRData1.remove();
 
 		m_dmrSpace1--;
 	}
 
 	if (m_dmrSpace2 > 1U && !m_txDMRData2.isEmpty()) {
-		unsigned char len = 0U;
-		m_txDMRData2.getData(&len, 1U);
-		m_txDMRData2.getData(m_buffer, len);
-
-		if (m_debug)
-			CUtils::dump(1U, "TX DMR Data 2", m_buffer, len);
-
-		int ret = m_serial.write(m_buffer, len);
-		if (ret != int(len))
-			LogWarning("Error when writing DMR data to the MMDVM");
+		writeDMRFrame(m_txDMRData2.peek(), MMDVM_DMR_DATA2);
+		m_txDMRData2.remove();
 
 		m_dmrSpace2--;
 	}
@@ -430,25 +297,41 @@ void CModem::clock(unsigned int ms)
 	if (m_ysfSpace > 1U && !m_txYSFData.isEmpty()) {
 		unsigned char len = 0U;
 		m_txYSFData.getData(&len, 1U);
-		m_txYSFData.getData(m_buffer, len);
+		m_txYSFData.getData(m_txBuffer, len);
 
 		if (m_debug)
-			CUtils::dump(1U, "TX YSF Data", m_buffer, len);
+			CUtils::dump(1U, "TX YSF Data", m_txBuffer, len);
+
+		CFrameCapture::add(CS_MODEM, CD_TX, 0U, m_txBuffer[2U], m_txBuffer, len);
 
-		int ret = m_serial.write(m_buffer, len);
-		if (ret != int(len))
+		int ret = m_serial.write(m_txBuffer, len);
+		if (ret != int(len)) {
 			LogWarning("Error when writing YSF data to the MMDVM");
+			CFrameCapture::error("after an error writing to the MMDVM");
+		}
 
 		m_ysfSpace--;
 	}
 }
 
+int CModem::getFd() const
+{
+	return m_serial.getFd();
+}
+
+// Bytes read but not yet parsed, or frames parsed but not yet read, only one frame per queue is read in a pass
+bool CModem::hasBufferedData() const
+{
+	if (m_readPtr < m_readLength)
+		return true;
+
+	return m_rxDStarData.hasData() || !m_rxDMRData1.isEmpty() || !m_rxDMRData2.isEmpty() || m_rxYSFData.hasData();
+}
+
 void CModem::close()
 {
 	::LogMessage("Closing the MMDVM");
 
-	delete[] m_buffer;
-	
 	m_serial.close();
 }
 
@@ -466,32 +349,14 @@ unsigned int CModem::readDStarData(unsigned char* data)
 	return len;
 }
 
-unsigned int CModem::readDMRData1(unsigned char* data)
+bool CModem::readDMRData1(CDMRFrame& frame)
 {
-	assert(data != NULL);
-
-	if (m_rxDMRData1.isEmpty())
-		return 0U;
-
-	unsigned char len = 0U;
-	m_rxDMRData1.getData(&len, 1U);
-	m_rxDMRData1.getData(data, len);
-
-	return len;
+	return m_rxDMRData1.get(frame);
 }
 
-unsigned int CModem::readDMRData2(unsigned char* data)
+bool CModem::readDMRData2(CDMRFrame& frame)
 {
-	assert(data != NULL);
-
-	if (m_rxDMRData2.isEmpty())
-		return 0U;
-
-	unsigned char len = 0U;
-	m_rxDMRData2.getData(&len, 1U);
-	m_rxDMRData2.getData(data, len);
-
-	return len;
+	return m_rxDMRData2.get(frame);
 }
 
 unsigned int CModem::readYSFData(unsigned char* data)
@@ -543,37 +408,29 @@ bool CModem::writeDStarData(const unsigned char* data, unsigned int length)
 
 bool CModem::hasDMRSpace1() const
 {
-	unsigned int space = m_txDMRData1.freeSpace() / (DMR_FRAME_LENGTH_BYTES + 4U);
-
-	return space > 1U;
+	return m_txDMRData1.hasSpace(2U);
 }
 
 bool CModem::hasDMRSpace2() const
 {
-	unsigned int space = m_txDMRData2.freeSpace() / (DMR_FRAME_LENGTH_BYTES + 4U);
-
-	return space > 1U;
+	return m_txDMRData2.hasSpace(2U);
 }
 
 bool CModem::writeDMRData1(const unsigned char* data, unsigned int length)
 {
 	assert(data != NULL);
-	assert(length > 0U);
+	assert(length == DMR_FRAME_LENGTH_BYTES + 2U);
 
 	if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
 		return false;
 
-	unsigned char buffer[40U];
-
-	buffer[0U] = MMDVM_FRAME_START;
-	buffer[1U] = length + 2U;
-	buffer[2U] = MMDVM_DMR_DATA1;
-
-	::memcpy(buffer + 3U, data + 1U, length - 1U);
+	// The frame is queued as received, the MMDVM header is added when it is sent
+	if (!m_txDMRData1.add(data))
+		return false;
 
-	unsigned char len = length + 2U;
-	m_txDMRData1.addData(&len, 1U);
-	m_txDMRData1.addData(buffer, len);
+	unsigned int depth = m_txDMRData1.depth();
+	if (depth > m_txDMRMaxDepth1)
+		m_txDMRMaxDepth1 = depth;
 
 	return true;
 }
@@ -581,22 +438,18 @@ bool CModem::writeDMRData1(const unsigned char* data, unsigned int length)
 bool CModem::writeDMRData2(const unsigned char* data, unsigned int length)
 {
 	assert(data != NULL);
-	assert(length > 0U);
+	assert(length == DMR_FRAME_LENGTH_BYTES + 2U);
 
 	if (data[0U] != TAG_DATA && data[0U] != TAG_EOT)
 		return false;
 
-	unsigned char buffer[40U];
-
-	buffer[0U] = MMDVM_FRAME_START;
-	buffer[1U] = length + 2U;
-	buffer[2U] = MMDVM_DMR_DATA2;
-
-	::memcpy(buffer + 3U, data + 1U, length - 1U);
+	// The frame is queued as received, the MMDVM header is added when it is sent
+	if (!m_txDMRData2.add(data))
+		return false;
 
-	unsigned char len = length + 2U;
-	m_txDMRData2.addData(&len, 1U);
-	m_txDMRData2.addData(buffer, len);
+	unsigned int depth = m_txDMRData2.depth();
+	if (depth > m_txDMRMaxDepth2)
+		m_txDMRMaxDepth2 = depth;
 
 	return true;
 }
@@ -659,7 +512,7 @@ bool CModem::readVersion()
 			::usleep(10000UL);
 #endif
 			unsigned int length;
-			RESP_TYPE_MMDVM resp = getResponse(m_buffer, length);
+			RESP_TYPE_MMDVM resp = getResponse(length);
 			if (resp == RTM_OK && m_buffer[2U] == MMDVM_GET_VERSION) {
 				LogInfo("MMDVM protocol version: %u, description: %.*s", m_buffer[3U], length - 4U, m_buffer + 4U);
 				return true;
@@ -739,7 +592,7 @@ bool CModem::setConfig()
 #else
 		::usleep(10000UL);
 #endif
-		resp = getResponse(m_buffer, length);
+		resp = getResponse(length);
 
 		if (resp == RTM_OK && m_buffer[2U] != MMDVM_ACK && m_buffer[2U] != MMDVM_NAK) {
 			count++;
@@ -760,60 +613,74 @@ bool CModem::setConfig()
 	return true;
 }
 
-RESP_TYPE_MMDVM CModem::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_MMDVM CModem::getResponse(unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = m_serial.read(buffer + 0U, 1U);
-	if (ret < 0) {
-		LogError("Error when reading from the modem");
-		return RTM_ERROR;
-	}
-
-	if (ret == 0)
-		return RTM_TIMEOUT;
-
-	if (buffer[0U] != MMDVM_FRAME_START)
-		return RTM_TIMEOUT;
-
-	ret = m_serial.read(buffer + 1U, 1U);
-	if (ret < 0) {
-		LogError("Error when reading from the modem");
-		return RTM_ERROR;
-	}
+	// Assemble a frame in m_buffer from whatever the serial port has, a partial
+	// frame is kept until the rest of it arrives on a later call
+	for (;;) {
+		if (m_readPtr == m_readLength) {
+			int ret = m_serial.readNonblock(m_readBuffer, READ_LENGTH);
+			if (ret < 0) {
+				LogError("Error when reading from the modem");
+				return RTM_ERROR;
+			}
 
-	if (ret == 0)
-		return RTM_TIMEOUT;
+			if (ret == 0)
+				return RTM_TIMEOUT;
 
-	length = buffer[1U];
+			m_readPtr    = 0U;
+			m_readLength = ret;
+		}
 
-	if (length >= 200U) {
-		LogError("Invalid data received from the modem");
-		return RTM_ERROR;
-	}
+		switch (m_rxState) {
+			case SS_START: {
+					// Skip anything that isn't the start of a frame
+					unsigned char c = m_readBuffer[m_readPtr++];
+					if (c == MMDVM_FRAME_START) {
+						m_buffer[0U] = c;
+						m_rxState = SS_LENGTH;
+					} else {
+						m_rxDiscarded++;
+					}
+				}
+				break;
 
-	unsigned int offset = 2U;
+			case SS_LENGTH: {
+					unsigned char c = m_readBuffer[m_readPtr];
+					if (c < 3U || c >= MAX_FRAME_LENGTH) {
+						// Not a valid frame, look for a new start at this byte
+						m_rxDiscarded++;
+						m_rxState = SS_START;
+						break;
+					}
+
+					m_readPtr++;
+					m_buffer[1U] = c;
+					m_rxLength = c;
+					m_rxOffset = 2U;
+					m_rxState  = SS_DATA;
+				}
+				break;
 
-	while (offset < length) {
-		int ret = m_serial.read(buffer + offset, length - offset);
-		if (ret < 0) {
-			LogError("Error when reading from the modem");
-			return RTM_ERROR;
+			default: {
+					unsigned int count = m_rxLength - m_rxOffset;
+					if (count > (m_readLength - m_readPtr))
+						count = m_readLength - m_readPtr;
+
+					::memcpy(m_buffer + m_rxOffset, m_readBuffer + m_readPtr, count);
+					m_rxOffset += count;
+					m_readPtr  += count;
+
+					if (m_rxOffset == m_rxLength) {
+						// CUtils::dump("Received", m_buffer, m_rxLength);
+						m_rxState = SS_START;
+						length = m_rxLength;
+						return RTM_OK;
+					}
+				}
+				break;
 		}
-
-		if (ret > 0)
-			offset += ret;
-
-		if (ret == 0)
-#if defined(_WIN32) || defined(_WIN64)
-			::Sleep(5UL);		// 5ms
-#else
-			::usleep(5000);		// 5ms
-#endif
 	}
-
-	// CUtils::dump("Received", buffer, length);
-
-	return RTM_OK;
 }
 
 bool CModem::setMode(unsigned char mode)
@@ -873,6 +740,249 @@ bool CModem::writeDMRShortLC(const unsigned char* lc)
 	return m_serial.write(buffer, 12U) == 12;
 }
 
+void CModem::processResponse(unsigned int length)
+{
+	CFrameCapture::add(CS_MODEM, CD_RX, getSlot(m_buffer[2U]), m_buffer[2U], m_buffer, length);
+
+	switch (m_buffer[2U]) {
+		case MMDVM_DSTAR_HEADER:
+			if (m_debug)
+				CUtils::dump(1U, "RX D-Star Header", m_buffer, length);
+
+			addRXData(m_rxDStarData, TAG_HEADER, m_buffer + 3U, length - 3U);
+			break;
+
+		case MMDVM_DSTAR_DATA:
+			if (m_debug)
+				CUtils::dump(1U, "RX D-Star Data", m_buffer, length);
+
+			addRXData(m_rxDStarData, TAG_DATA, m_buffer + 3U, length - 3U);
+			break;
+
+		case MMDVM_DSTAR_LOST:
+			if (m_debug)
+				CUtils::dump(1U, "RX D-Star Lost", m_buffer, length);
+
+			addRXData(m_rxDStarData, TAG_LOST, NULL, 0U);
+			break;
+
+		case MMDVM_DSTAR_EOT:
+			if (m_debug)
+				CUtils::dump(1U, "RX D-Star EOT", m_buffer, length);
+
+			addRXData(m_rxDStarData, TAG_EOT, NULL, 0U);
+			break;
+
+		case MMDVM_DMR_DATA1: {
+				if (m_debug)
+					CUtils::dump(1U, "RX DMR Data 1", m_buffer, length);
+
+				unsigned char tag = (m_buffer[3U] == (DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC)) ? TAG_EOT : TAG_DATA;
+				addRXFrame(m_rxDMRData1, tag, m_buffer + 3U, length - 3U);
+			}
+			break;
+
+		case MMDVM_DMR_DATA2: {
+				if (m_debug)
+					CUtils::dump(1U, "RX DMR Data 2", m_buffer, length);
+
+				unsigned char tag = (m_buffer[3U] == (DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC)) ? TAG_EOT : TAG_DATA;
+				addRXFrame(m_rxDMRData2, tag, m_buffer + 3U, length - 3U);
+			}
+			break;
+
+		case MMDVM_DMR_LOST1:
+			if (m_debug)
+				CUtils::dump(1U, "RX DMR Lost 1", m_buffer, length);
+
+			addRXFrame(m_rxDMRData1, TAG_LOST, NULL, 0U);
+			break;
+
+		case MMDVM_DMR_LOST2:
+			if (m_debug)
+				CUtils::dump(1U, "RX DMR Lost 2", m_buffer, length);
+
+			addRXFrame(m_rxDMRData2, TAG_LOST, NULL, 0U);
+			break;
+
+		case MMDVM_YSF_DATA: {
+				if (m_debug)
+					CUtils::dump(1U, "RX YSF Data", m_buffer, length);
+
+				unsigned char tag = ((m_buffer[3U] & (YSF_CKSUM_OK | YSF_FI_MASK)) == (YSF_CKSUM_OK | YSF_DT_TERMINATOR_CHANNEL)) ? TAG_EOT : TAG_DATA;
+				addRXData(m_rxYSFData, tag, m_buffer + 3U, length - 3U);
+			}
+			break;
+
+		case MMDVM_YSF_LOST:
+			if (m_debug)
+				CUtils::dump(1U, "RX YSF Lost", m_buffer, length);
+
+			addRXData(m_rxYSFData, TAG_LOST, NULL, 0U);
+			break;
+
+		case MMDVM_GET_STATUS: {
+				// if (m_debug)
+				//	CUtils::dump(1U, "GET_STATUS", m_buffer, length);
+
+				m_tx = (m_buffer[5U] & 0x01U) == 0x01U;
+
+				bool adcOverflow = (m_buffer[5U] & 0x02U) == 0x02U;
+				if (adcOverflow) {
+					LogError("MMDVM ADC levels have overflowed");
+					CFrameCapture::error("after the MMDVM ADC levels overflowed");
+				}
+
+				bool rxOverflow = (m_buffer[5U] & 0x04U) == 0x04U;
+				if (rxOverflow) {
+					LogError("MMDVM RX buffer has overflowed");
+					CFrameCapture::error("after the MMDVM RX buffer overflowed");
+				}
+
+				bool txOverflow = (m_buffer[5U] & 0x08U) == 0x08U;
+				if (txOverflow) {
+					LogError("MMDVM TX buffer has overflowed");
+					CFrameCapture::error("after the MMDVM TX buffer overflowed");
+				}
+
+				m_dstarSpace = m_buffer[6U];
+				m_dmrSpace1  = m_buffer[7U];
+				m_dmrSpace2  = m_buffer[8U];
+				m_ysfSpace   = m_buffer[9U];
+				// LogMessage("status=%02X, tx=%d, space=%u,%u,%u,%u", m_buffer[5U], int(m_tx), m_dstarSpace, m_dmrSpace1, m_dmrSpace2, m_ysfSpace);
+			}
+			break;
+
+		// These should not be received, but don't complain if we do
+		case MMDVM_GET_VERSION:
+		case MMDVM_ACK:
+			break;
+
+		case MMDVM_NAK:
+			LogWarning("Received a NAK from the MMDVM, command = 0x%02X, reason = %u", m_buffer[3U], m_buffer[4U]);
+			break;
+
+		case MMDVM_DEBUG1:
+		case MMDVM_DEBUG2:
+		case MMDVM_DEBUG3:
+		case MMDVM_DEBUG4:
+		case MMDVM_DEBUG5:
+			printDebug();
+			break;
+
+		case MMDVM_SAMPLES:
+			// printSamples();
+			break;
+
+		default:
+			LogMessage("Unknown message, type: %02X", m_buffer[2U]);
+			CUtils::dump("Buffer dump", m_buffer, length);
+			break;
+	}
+}
+
+void CModem::addRXData(CRingBuffer<unsigned char>& buffer, unsigned char tag, const unsigned char* data, unsigned int length)
+{
+	// Stored as a length byte, the tag and then the data
+	unsigned int total = length + 2U;
+
+	unsigned int space;
+	unsigned char* ptr = buffer.getWriteSpan(space);
+	if (space < total) {
+		// The record would wrap, so write it in pieces
+		if (!buffer.hasSpace(total)) {
+			LogWarning("No space to store data received from the MMDVM");
+			return;
+		}
+
+		unsigned char header[2U];
+		header[0U] = length + 1U;
+		header[1U] = tag;
+		buffer.addData(header, 2U);
+		if (length > 0U)
+			buffer.addData(data, length);
+		return;
+	}
+
+	ptr[0U] = length + 1U;
+	ptr[1U] = tag;
+	if (length > 0U)
+		::memcpy(ptr + 2U, data, length);
+
+	buffer.commitWrite(total);
+}
+
+void CModem::addRXFrame(CDMRFrameQueue& queue, unsigned char tag, const unsigned char* data, unsigned int length)
+{
+	if (length > DMR_FRAME_LENGTH_BYTES + 1U) {
+		LogWarning("DMR data from the MMDVM is too long, %u bytes", length);
+		return;
+	}
+
+	// This is the only copy of the frame between here and the network
+	CDMRFrame frame;
+	frame.create();
+	frame.setTime();
+
+	unsigned char* ptr = frame.getData();
+	ptr[0U] = tag;
+	if (length > 0U) {
+		::memcpy(ptr + 1U, data, length);
+		CDMRFrame::countCopy(DCH_MODEM);
+	}
+
+	frame.setLength(length + 1U);
+
+	if (!queue.add(frame))
+		LogWarning("No space to store data received from the MMDVM");
+}
+
+void CModem::printStats()
+{
+	if (m_rxTicks > 0U)
+		LogDebug("MMDVM frames received: %u in %u ticks, average %.1f/tick, maximum %u/tick, budget reached %u times", m_rxFrames, m_rxTicks, float(m_rxFrames) / float(m_rxTicks), m_rxMaxFrames, m_rxBudgetHits);
+
+	if (m_rxDiscarded > 0U)
+		LogDebug("MMDVM bytes discarded while resynchronising: %u", m_rxDiscarded);
+
+	m_rxFrames     = 0U;
+	m_rxTicks      = 0U;
+	m_rxMaxFrames  = 0U;
+	m_rxBudgetHits = 0U;
+	m_rxDiscarded  = 0U;
+
+	if (m_txDMRMaxDepth1 > 0U || m_txDMRMaxDepth2 > 0U)
+		LogDebug("MMDVM DMR transmit queues, maximum depth: slot 1 %u frames, slot 2 %u frames", m_txDMRMaxDepth1, m_txDMRMaxDepth2);
+
+	m_txDMRMaxDepth1 = 0U;
+	m_txDMRMaxDepth2 = 0U;
+}
+
+void CModem::writeDMRFrame(const unsigned char* frame, unsigned char type)
+{
+	assert(frame != NULL);
+
+	// Drop the tag, the rest of the queued frame follows the header unchanged
+	unsigned int len = DMR_FRAME_LENGTH_BYTES + 4U;
+
+	m_txBuffer[0U] = MMDVM_FRAME_START;
+	m_txBuffer[1U] = len;
+	m_txBuffer[2U] = type;
+
+	::memcpy(m_txBuffer + 3U, frame + 1U, DMR_FRAME_LENGTH_BYTES + 1U);
+
+	if (m_debug)
+		CUtils::dump(1U, type == MMDVM_DMR_DATA1 ? "TX DMR Data 1" : "TX DMR Data 2", m_txBuffer, len);
+
+	CFrameCapture::add(CS_MODEM, CD_TX, getSlot(type), type, m_txBuffer, len);
+
+	int ret = m_serial.write(m_txBuffer, len);
+	if (ret != int(len)) {
+		LogWarning("Error when writing DMR data to the MMDVM");
+		CFrameCapture::error("after an error writing to the MMDVM");
+	}
+}
+
 void CModem::printDebug()
 {
 	unsigned int length = m_buffer[1U];
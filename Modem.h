@@ -20,7 +20,10 @@
 #define	MODEM_H
 
 #include "SerialController.h"
+#include "FrameQueue.h"
 #include "RingBuffer.h"
+#include "DMRDefines.h"
+#include "DMRFrame.h"
 #include "Timer.h"
 
 #include <string>
@@ -31,6 +34,12 @@ enum RESP_TYPE_MMDVM {
 	RTM_ERROR
 };
 
+enum SERIAL_STATE {
+	SS_START,
+	SS_LENGTH,
+	SS_DATA
+};
+
 class CModem {
 public:
 	CModem(const std::string& port, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel, bool debug = false);
@@ -38,12 +47,13 @@ public:
 
 	virtual void setModeParams(bool dstarEnabled, bool dmrEnabled, bool ysfEnabled);
 	virtual void setDMRParams(unsigned int colorCode);
+	virtual void setFramesPerTick(unsigned int frames);
 
 	virtual bool open();
 
 	virtual unsigned int readDStarData(unsigned char* data);
-	virtual unsigned int readDMRData1(unsigned char* data);
-	virtual unsigned int readDMRData2(unsigned char* data);
+	virtual bool readDMRData1(CDMRFrame& frame);
+	virtual bool readDMRData2(CDMRFrame& frame);
 	virtual unsigned int readYSFData(unsigned char* data);
 
 	virtual bool hasDStarSpace() const;
@@ -63,6 +73,11 @@ public:
 
 	virtual void clock(unsigned int ms);
 
+	virtual int getFd() const;
+	virtual bool hasBufferedData() const;
+
+	virtual void printStats();
+
 	virtual void close();
 
 private:
@@ -80,12 +95,20 @@ private:
 	bool                       m_ysfEnabled;
 	CSerialController          m_serial;
 	unsigned char*             m_buffer;
+	unsigned char*             m_txBuffer;
+	unsigned char*             m_readBuffer;
+	unsigned int               m_readPtr;
+	unsigned int               m_readLength;
+	SERIAL_STATE               m_rxState;
+	unsigned int               m_rxOffset;
+	unsigned int               m_rxLength;
+	unsigned int               m_rxDiscarded;
 	CRingBuffer<unsigned char> m_rxDStarData;
 	CRingBuffer<unsigned char> m_txDStarData;
-	CRingBuffer<unsigned char> m_rxDMRData1;
-	CRingBuffer<unsigned char> m_rxDMRData2;
-	CRingBuffer<unsigned char> m_txDMRData1;
-	CRingBuffer<unsigned char> m_txDMRData2;
+	CDMRFrameQueue             m_rxDMRData1;
+	CDMRFrameQueue             m_rxDMRData2;
+	CFrameQueue<DMR_FRAME_LENGTH_BYTES + 2U> m_txDMRData1;
+	CFrameQueue<DMR_FRAME_LENGTH_BYTES + 2U> m_txDMRData2;
 	CRingBuffer<unsigned char> m_rxYSFData;
 	CRingBuffer<unsigned char> m_txYSFData;
 	CTimer                     m_statusTimer;
@@ -94,14 +117,27 @@ private:
 	unsigned int               m_dmrSpace2;
 	unsigned int               m_ysfSpace;
 	bool                       m_tx;
+	unsigned int               m_framesPerTick;
+	unsigned int               m_rxFrames;
+	unsigned int               m_rxTicks;
+	unsigned int               m_rxMaxFrames;
+	unsigned int               m_rxBudgetHits;
+	unsigned int               m_txDMRMaxDepth1;
+	unsigned int               m_txDMRMaxDepth2;
 
 	bool readVersion();
 	bool readStatus();
 	bool setConfig();
 
+	void processResponse(unsigned int length);
+	void addRXData(CRingBuffer<unsigned char>& buffer, unsigned char tag, const unsigned char* data, unsigned int length);
+	void addRXFrame(CDMRFrameQueue& queue, unsigned char tag, const unsigned char* data, unsigned int length);
+
+	void writeDMRFrame(const unsigned char* frame, unsigned char type);
+
 	void printDebug();
 
-	RESP_TYPE_MMDVM getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_MMDVM getResponse(unsigned int& length);
 };
 
 #endif
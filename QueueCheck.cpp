@@ -0,0 +1,231 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Passes numbered frames between threads through the lock-free queues, one
+// producer for CSPSCRingBuffer and four for CMPSCQueue, and checks that every
+// frame arrives once, in its producer's order and intact. The queues are
+// kept short so that they wrap and fill up many times over. To have the
+// sanitizer check the memory ordering too, build it on its own with
+//
+//   g++ -O1 -g -std=c++11 -fsanitize=thread -o QueueCheck QueueCheck.cpp -lpthread
+
+#include "SPSCRingBuffer.h"
+#include "MPSCQueue.h"
+
+#include <atomic>
+#include <thread>
+
+#include <cstdio>
+#include <cstring>
+
+const unsigned int SPSC_FRAMES = 1000000U;
+
+// Not a multiple of any frame length, so that frames straddle the end
+const unsigned int SPSC_LENGTH = 1000U;
+
+const unsigned int MAX_FRAME_LENGTH = 100U;
+
+const unsigned int MPSC_PRODUCERS = 4U;
+const unsigned int MPSC_ITEMS     = 250000U;
+const unsigned int MPSC_LENGTH    = 64U;
+
+struct MPSC_ITEM {
+	unsigned int m_producer;
+	unsigned int m_n;
+	unsigned int m_check;
+};
+
+// The length and contents of a frame follow from its number
+static unsigned int makeFrame(unsigned int n, unsigned char* frame)
+{
+	unsigned int length = 4U + n % (MAX_FRAME_LENGTH - 3U);
+
+	frame[0U] = n >> 24;
+	frame[1U] = n >> 16;
+	frame[2U] = n >> 8;
+	frame[3U] = n >> 0;
+
+	for (unsigned int i = 4U; i < length; i++)
+		frame[i] = n * 31U + i;
+
+	return length;
+}
+
+static std::atomic<bool> m_finished(false);
+
+static void spscProducer(CSPSCRingBuffer<unsigned char>* buffer)
+{
+	for (unsigned int n = 0U; n < SPSC_FRAMES; n++) {
+		unsigned char frame[MAX_FRAME_LENGTH];
+		unsigned int length = makeFrame(n, frame);
+
+		while (!buffer->addFrame(frame, length))
+			std::this_thread::yield();
+	}
+
+	m_finished.store(true);
+}
+
+// Returns the number of frames that were lost, repeated, out of order or corrupted
+static unsigned int checkSPSC()
+{
+	CSPSCRingBuffer<unsigned char> buffer(SPSC_LENGTH);
+
+	m_finished.store(false);
+
+	std::thread producer(spscProducer, &buffer);
+
+	unsigned int errors = 0U;
+
+	unsigned int n = 0U;
+	for (;;) {
+		// Check for the end before looking for a frame, so that the last frames aren't missed
+		bool finished = m_finished.load();
+
+		unsigned char frame[MAX_FRAME_LENGTH];
+		unsigned int length = buffer.getFrame(frame);
+		if (length == 0U) {
+			if (finished)
+				break;
+
+			std::this_thread::yield();
+			continue;
+		}
+
+		unsigned char expected[MAX_FRAME_LENGTH];
+		unsigned int expectedLength = makeFrame(n, expected);
+
+		if (length != expectedLength || ::memcmp(frame, expected, length) != 0) {
+			errors++;
+
+			// Carry on from the number in the frame, if it has one
+			if (length >= 4U)
+				n = (frame[0U] << 24) | (frame[1U] << 16) | (frame[2U] << 8) | frame[3U];
+		}
+
+		n++;
+	}
+
+	producer.join();
+
+	// Frames missing from the end
+	if (n < SPSC_FRAMES)
+		errors += SPSC_FRAMES - n;
+
+	return errors;
+}
+
+static std::atomic<unsigned int> m_producers(0U);
+
+static void mpscProducer(CMPSCQueue<MPSC_ITEM>* queue, unsigned int producer)
+{
+	for (unsigned int n = 0U; n < MPSC_ITEMS; n++) {
+		MPSC_ITEM item;
+		item.m_producer = producer;
+		item.m_n        = n;
+		item.m_check    = (producer * MPSC_ITEMS + n) * 2654435761U;
+
+		while (!queue->add(item))
+			std::this_thread::yield();
+	}
+
+	m_producers.fetch_sub(1U);
+}
+
+// Each producer's items must arrive in the order that it added them, the
+// order between producers is whatever the race for the slots gave
+static unsigned int checkMPSC()
+{
+	CMPSCQueue<MPSC_ITEM> queue(MPSC_LENGTH);
+
+	m_producers.store(MPSC_PRODUCERS);
+
+	std::thread* producers[MPSC_PRODUCERS];
+	for (unsigned int i = 0U; i < MPSC_PRODUCERS; i++)
+		producers[i] = new std::thread(mpscProducer, &queue, i);
+
+	unsigned int next[MPSC_PRODUCERS];
+	for (unsigned int i = 0U; i < MPSC_PRODUCERS; i++)
+		next[i] = 0U;
+
+	unsigned int errors = 0U;
+
+	for (;;) {
+		// Check for the end before looking for an item, so that the last items aren't missed
+		bool finished = m_producers.load() == 0U;
+
+		MPSC_ITEM item;
+		if (!queue.get(item)) {
+			if (finished)
+				break;
+
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (item.m_producer >= MPSC_PRODUCERS || item.m_check != (item.m_producer * MPSC_ITEMS + item.m_n) * 2654435761U) {
+			errors++;
+			continue;
+		}
+
+		if (item.m_n != next[item.m_producer])
+			errors++;
+
+		next[item.m_producer] = item.m_n + 1U;
+	}
+
+	for (unsigned int i = 0U; i < MPSC_PRODUCERS; i++) {
+		producers[i]->join();
+		delete producers[i];
+
+		// Items missing from the end
+		if (next[i] < MPSC_ITEMS)
+			errors += MPSC_ITEMS - next[i];
+	}
+
+	return errors;
+}
+
+static bool check(const char* name, unsigned int errors)
+{
+	if (errors > 0U) {
+		::fprintf(stdout, "%-8s FAILED, %u bad frames\n", name, errors);
+		return false;
+	}
+
+	::fprintf(stdout, "%-8s OK\n", name);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failed = 0U;
+
+	if (!check("SPSC", checkSPSC()))
+		failed++;
+	if (!check("MPSC", checkMPSC()))
+		failed++;
+
+	if (failed > 0U) {
+		::fprintf(stdout, "%u queues lost or damaged frames\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
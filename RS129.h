@@ -24,6 +24,8 @@ class CRS129
 public:
 	static bool check(const unsigned char* in);
 
+	static bool decode(unsigned char* in);
+
 	static void encode(const unsigned char* msg, unsigned int nbytes, unsigned char* parity);
 };
 
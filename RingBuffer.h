@@ -47,29 +47,24 @@ public:
 		if (nSamples > freeSpace())
 			return 0U;
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			m_buffer[m_iPtr++] = buffer[i];
+		// At most two copies, up to the end of the buffer and then from the start
+		unsigned int first = m_length - m_iPtr;
+		if (first > nSamples)
+			first = nSamples;
 
-			if (m_iPtr == m_length)
-				m_iPtr = 0U;
-		}
+		::memcpy(m_buffer + m_iPtr, buffer, first * sizeof(T));
+		::memcpy(m_buffer, buffer + first, (nSamples - first) * sizeof(T));
+
+		m_iPtr = advance(m_iPtr, nSamples);
 
 		return nSamples;
 	}
 
 	unsigned int getData(T* buffer, unsigned int nSamples)
 	{
-		unsigned int data = dataSize();
+		nSamples = peek(buffer, nSamples);
 
-		if (data < nSamples)
-			nSamples = data;
-
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[m_oPtr++];
-
-			if (m_oPtr == m_length)
-				m_oPtr = 0U;
-		}
+		m_oPtr = advance(m_oPtr, nSamples);
 
 		return nSamples;
 	}
@@ -81,17 +76,54 @@ public:
 		if (data < nSamples)
 			nSamples = data;
 
-		unsigned int ptr = m_oPtr;
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[ptr++];
+		unsigned int first = m_length - m_oPtr;
+		if (first > nSamples)
+			first = nSamples;
 
-			if (ptr == m_length)
-				ptr = 0U;
-		}
+		::memcpy(buffer, m_buffer + m_oPtr, first * sizeof(T));
+		::memcpy(buffer + first, m_buffer, (nSamples - first) * sizeof(T));
 
 		return nSamples;
 	}
 
+	// Returns the largest contiguous region that can be written to directly,
+	// the data only becomes visible to the reader after a call to commitWrite()
+	T* getWriteSpan(unsigned int& nSamples)
+	{
+		if (m_iPtr >= m_oPtr)
+			nSamples = (m_oPtr == 0U) ? m_length - m_iPtr - 1U : m_length - m_iPtr;
+		else
+			nSamples = m_oPtr - m_iPtr - 1U;
+
+		return m_buffer + m_iPtr;
+	}
+
+	void commitWrite(unsigned int nSamples)
+	{
+		assert(nSamples <= freeSpace());
+
+		m_iPtr = advance(m_iPtr, nSamples);
+	}
+
+	// Returns the largest contiguous region that can be read directly, the data
+	// stays in the buffer until a call to commitRead()
+	const T* getReadSpan(unsigned int& nSamples) const
+	{
+		if (m_iPtr >= m_oPtr)
+			nSamples = m_iPtr - m_oPtr;
+		else
+			nSamples = m_length - m_oPtr;
+
+		return m_buffer + m_oPtr;
+	}
+
+	void commitRead(unsigned int nSamples)
+	{
+		assert(nSamples <= dataSize());
+
+		m_oPtr = advance(m_oPtr, nSamples);
+	}
+
 	void clear()
 	{
 		m_iPtr  = 0U;
@@ -139,6 +171,15 @@ private:
 
 		return m_length - (m_oPtr - m_iPtr);
 	}
+
+	unsigned int advance(unsigned int ptr, unsigned int nSamples) const
+	{
+		ptr += nSamples;
+		if (ptr >= m_length)
+			ptr -= m_length;
+
+		return ptr;
+	}
 };
 
 #endif
@@ -0,0 +1,262 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef SPSCRingBuffer_H
+#define SPSCRingBuffer_H
+
+#include <atomic>
+#include <limits>
+#include <cassert>
+#include <cstring>
+
+const unsigned int SPSC_CACHE_LINE = 64U;
+
+// A ring buffer for passing data from exactly one producer thread to exactly
+// one consumer thread without locks. The write pointer is only stored by the
+// producer and the read pointer only by the consumer, each side keeps a copy
+// of the other's pointer and only reloads it when it appears to be short of
+// space or data.
+//
+// addFrame()/getFrame() keep the same layout as the framed use of CRingBuffer,
+// a length followed by the data, but publish the whole frame at once so that
+// the consumer never sees a length without its data.
+template<class T> class CSPSCRingBuffer {
+public:
+	CSPSCRingBuffer(unsigned int length) :
+	m_length(length),
+	m_buffer(NULL),
+	m_iPtr(0U),
+	m_oPtrCache(0U),
+	m_oPtr(0U),
+	m_iPtrCache(0U)
+	{
+		assert(length > 1U);
+
+		m_buffer = new T[length];
+
+		::memset(m_buffer, 0x00, m_length * sizeof(T));
+	}
+
+	~CSPSCRingBuffer()
+	{
+		delete[] m_buffer;
+	}
+
+	// Producer side
+
+	unsigned int addData(const T* buffer, unsigned int nSamples)
+	{
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+
+		if (nSamples > producerSpace(iPtr, nSamples))
+			return 0U;
+
+		write(iPtr, buffer, nSamples);
+
+		m_iPtr.store(advance(iPtr, nSamples), std::memory_order_release);
+
+		return nSamples;
+	}
+
+	// The length is held in a single T, so a longer frame is refused
+	bool addFrame(const T* buffer, unsigned int nSamples)
+	{
+		assert(nSamples <= (unsigned int)std::numeric_limits<T>::max());
+
+		if (nSamples > (unsigned int)std::numeric_limits<T>::max())
+			return false;
+
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+
+		if ((nSamples + 1U) > producerSpace(iPtr, nSamples + 1U))
+			return false;
+
+		T len = T(nSamples);
+		write(iPtr, &len, 1U);
+		write(advance(iPtr, 1U), buffer, nSamples);
+
+		m_iPtr.store(advance(iPtr, nSamples + 1U), std::memory_order_release);
+
+		return true;
+	}
+
+	bool hasSpace(unsigned int length)
+	{
+		return producerSpace(m_iPtr.load(std::memory_order_relaxed), length + 1U) > length;
+	}
+
+	// Consumer side
+
+	unsigned int getData(T* buffer, unsigned int nSamples)
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+
+		unsigned int data = consumerData(oPtr, nSamples);
+		if (data < nSamples)
+			nSamples = data;
+
+		read(oPtr, buffer, nSamples);
+
+		m_oPtr.store(advance(oPtr, nSamples), std::memory_order_release);
+
+		return nSamples;
+	}
+
+	unsigned int peek(T* buffer, unsigned int nSamples)
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+
+		unsigned int data = consumerData(oPtr, nSamples);
+		if (data < nSamples)
+			nSamples = data;
+
+		read(oPtr, buffer, nSamples);
+
+		return nSamples;
+	}
+
+	// Returns the length of the frame copied into buffer, or zero if there is no frame waiting
+	unsigned int getFrame(T* buffer)
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+
+		if (consumerData(oPtr, 1U) == 0U)
+			return 0U;
+
+		T len;
+		read(oPtr, &len, 1U);
+
+		unsigned int nSamples = (unsigned int)len;
+		assert(consumerData(oPtr, nSamples + 1U) >= (nSamples + 1U));
+
+		read(advance(oPtr, 1U), buffer, nSamples);
+
+		m_oPtr.store(advance(oPtr, nSamples + 1U), std::memory_order_release);
+
+		return nSamples;
+	}
+
+	bool hasData()
+	{
+		return consumerData(m_oPtr.load(std::memory_order_relaxed), 1U) > 0U;
+	}
+
+	bool isEmpty()
+	{
+		return !hasData();
+	}
+
+	// Either side, the answer may be stale by the time it is used
+
+	unsigned int freeSpace() const
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		return m_length - used(iPtr, oPtr) - 1U;
+	}
+
+	unsigned int dataSize() const
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		return used(iPtr, oPtr);
+	}
+
+private:
+	unsigned int              m_length;
+	T*                        m_buffer;
+	char                      m_pad0[SPSC_CACHE_LINE];
+
+	// Written by the producer
+	std::atomic<unsigned int> m_iPtr;
+	unsigned int              m_oPtrCache;
+	char                      m_pad1[SPSC_CACHE_LINE - sizeof(std::atomic<unsigned int>) - sizeof(unsigned int)];
+
+	// Written by the consumer
+	std::atomic<unsigned int> m_oPtr;
+	unsigned int              m_iPtrCache;
+	char                      m_pad2[SPSC_CACHE_LINE - sizeof(std::atomic<unsigned int>) - sizeof(unsigned int)];
+
+	CSPSCRingBuffer(const CSPSCRingBuffer&);
+	CSPSCRingBuffer& operator=(const CSPSCRingBuffer&);
+
+	unsigned int used(unsigned int iPtr, unsigned int oPtr) const
+	{
+		if (iPtr >= oPtr)
+			return iPtr - oPtr;
+
+		return m_length - (oPtr - iPtr);
+	}
+
+	// Only reload the consumer's pointer if the cached copy doesn't show enough space
+	unsigned int producerSpace(unsigned int iPtr, unsigned int needed)
+	{
+		unsigned int space = m_length - used(iPtr, m_oPtrCache) - 1U;
+		if (space >= needed)
+			return space;
+
+		m_oPtrCache = m_oPtr.load(std::memory_order_acquire);
+
+		return m_length - used(iPtr, m_oPtrCache) - 1U;
+	}
+
+	// Only reload the producer's pointer if the cached copy doesn't show enough data
+	unsigned int consumerData(unsigned int oPtr, unsigned int needed)
+	{
+		unsigned int data = used(m_iPtrCache, oPtr);
+		if (data >= needed)
+			return data;
+
+		m_iPtrCache = m_iPtr.load(std::memory_order_acquire);
+
+		return used(m_iPtrCache, oPtr);
+	}
+
+	void write(unsigned int iPtr, const T* buffer, unsigned int nSamples)
+	{
+		unsigned int first = m_length - iPtr;
+		if (first > nSamples)
+			first = nSamples;
+
+		::memcpy(m_buffer + iPtr, buffer, first * sizeof(T));
+		::memcpy(m_buffer, buffer + first, (nSamples - first) * sizeof(T));
+	}
+
+	void read(unsigned int oPtr, T* buffer, unsigned int nSamples) const
+	{
+		unsigned int first = m_length - oPtr;
+		if (first > nSamples)
+			first = nSamples;
+
+		::memcpy(buffer, m_buffer + oPtr, first * sizeof(T));
+		::memcpy(buffer + first, m_buffer, (nSamples - first) * sizeof(T));
+	}
+
+	unsigned int advance(unsigned int ptr, unsigned int nSamples) const
+	{
+		ptr += nSamples;
+		if (ptr >= m_length)
+			ptr -= m_length;
+
+		return ptr;
+	}
+};
+
+#endif
@@ -258,6 +258,11 @@ int CSerialController::write(const unsigned char* buffer, unsigned int length)
 	return int(length);
 }
 
+int CSerialController::getFd() const
+{
+	return -1;
+}
+
 void CSerialController::close()
 {
 	assert(m_handle != INVALID_HANDLE_VALUE);
@@ -430,6 +435,27 @@ int CSerialController::read(unsigned char* buffer, unsigned int length)
 	return length;
 }
 
+int CSerialController::readNonblock(unsigned char* buffer, unsigned int length)
+{
+	assert(buffer != NULL);
+	assert(m_fd != -1);
+
+	if (length == 0U)
+		return 0;
+
+	// The port is opened with O_NDELAY so this returns whatever is available
+	ssize_t len = ::read(m_fd, buffer, length);
+	if (len < 0) {
+		if (errno == EAGAIN)
+			return 0;
+
+		LogError("Error from read(), errno=%d", errno);
+		return -1;
+	}
+
+	return int(len);
+}
+
 int CSerialController::write(const unsigned char* buffer, unsigned int length)
 {
 	assert(buffer != NULL);
@@ -456,6 +482,11 @@ int CSerialController::write(const unsigned char* buffer, unsigned int length)
 	return length;
 }
 
+int CSerialController::getFd() const
+{
+	return m_fd;
+}
+
 void CSerialController::close()
 {
 	assert(m_fd != -1);
@@ -46,8 +46,11 @@ public:
 	bool open();
 
 	int  read(unsigned char* buffer, unsigned int length);
+	int  readNonblock(unsigned char* buffer, unsigned int length);
 	int  write(const unsigned char* buffer, unsigned int length);
 
+	int  getFd() const;
+
 	void close();
 
 private:
@@ -64,10 +67,6 @@ private:
 #else
 	int            m_fd;
 #endif
-
-#if defined(_WIN32) || defined(_WIN64)
-	int readNonblock(unsigned char* buffer, unsigned int length);
-#endif
 };
 
 #endif
@@ -20,10 +20,10 @@
 #include "Log.h"
 
 #include <cassert>
+#include <cstring>
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <cerrno>
-#include <cstring>
 #endif
 
 
@@ -216,6 +216,64 @@ int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& addres
 	return len;
 }
 
+int CUDPSocket::readBatch(unsigned char* buffer, unsigned int length, unsigned int count, unsigned int* lengths, in_addr* addresses, unsigned int* ports)
+{
+	assert(buffer != NULL);
+	assert(length > 0U);
+	assert(count > 0U && count <= UDP_MAX_BATCH);
+	assert(lengths != NULL);
+	assert(addresses != NULL);
+	assert(ports != NULL);
+
+#if defined(_WIN32) || defined(_WIN64)
+	unsigned int n;
+	for (n = 0U; n < count; n++) {
+		int len = read(buffer + n * length, length, addresses[n], ports[n]);
+		if (len < 0)
+			return n > 0U ? int(n) : -1;
+		if (len == 0)
+			break;
+
+		lengths[n] = len;
+	}
+
+	return int(n);
+#else
+	mmsghdr     msgs[UDP_MAX_BATCH];
+	iovec       iovs[UDP_MAX_BATCH];
+	sockaddr_in addrs[UDP_MAX_BATCH];
+
+	::memset(msgs, 0x00, count * sizeof(mmsghdr));
+
+	for (unsigned int i = 0U; i < count; i++) {
+		iovs[i].iov_base = buffer + i * length;
+		iovs[i].iov_len  = length;
+
+		msgs[i].msg_hdr.msg_name    = addrs + i;
+		msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		msgs[i].msg_hdr.msg_iov     = iovs + i;
+		msgs[i].msg_hdr.msg_iovlen  = 1U;
+	}
+
+	int ret = ::recvmmsg(m_fd, msgs, count, MSG_DONTWAIT, NULL);
+	if (ret < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			return 0;
+
+		LogError("Error returned from recvmmsg, err: %d", errno);
+		return -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		lengths[i]   = msgs[i].msg_len;
+		addresses[i] = addrs[i].sin_addr;
+		ports[i]     = ntohs(addrs[i].sin_port);
+	}
+
+	return ret;
+#endif
+}
+
 bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port)
 {
 	assert(buffer != NULL);
@@ -253,6 +311,63 @@ bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const i
 	return true;
 }
 
+bool CUDPSocket::write(const unsigned char* header, unsigned int headerLength, const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port)
+{
+	assert(header != NULL);
+	assert(headerLength > 0U);
+	assert(buffer != NULL);
+	assert(length > 0U);
+
+#if defined(_WIN32) || defined(_WIN64)
+	unsigned char* data = new unsigned char[headerLength + length];
+	::memcpy(data, header, headerLength);
+	::memcpy(data + headerLength, buffer, length);
+
+	bool ret = write(data, headerLength + length, address, port);
+
+	delete[] data;
+
+	return ret;
+#else
+	sockaddr_in addr;
+	::memset(&addr, 0x00, sizeof(sockaddr_in));
+
+	addr.sin_family = AF_INET;
+	addr.sin_addr   = address;
+	addr.sin_port   = htons(port);
+
+	iovec iov[2U];
+	iov[0U].iov_base = (void*)header;
+	iov[0U].iov_len  = headerLength;
+	iov[1U].iov_base = (void*)buffer;
+	iov[1U].iov_len  = length;
+
+	msghdr msg;
+	::memset(&msg, 0x00, sizeof(msghdr));
+
+	msg.msg_name    = &addr;
+	msg.msg_namelen = sizeof(sockaddr_in);
+	msg.msg_iov     = iov;
+	msg.msg_iovlen  = 2U;
+
+	ssize_t ret = ::sendmsg(m_fd, &msg, 0);
+	if (ret < 0) {
+		LogError("Error returned from sendmsg, err: %d", errno);
+		return false;
+	}
+
+	if (ret != ssize_t(headerLength + length))
+		return false;
+
+	return true;
+#endif
+}
+
+int CUDPSocket::getFd() const
+{
+	return m_fd;
+}
+
 void CUDPSocket::close()
 {
 #if defined(_WIN32) || defined(_WIN64)
@@ -26,6 +26,7 @@
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -34,6 +35,9 @@
 #include <winsock.h>
 #endif
 
+// The most datagrams that readBatch() will return at once
+const unsigned int UDP_MAX_BATCH = 16U;
+
 class CUDPSocket {
 public:
 	CUDPSocket(const std::string& address, unsigned int port);
@@ -43,7 +47,13 @@ public:
 	bool open();
 
 	int  read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
+	// Reads up to count waiting datagrams without blocking, the n'th goes to buffer + n * length
+	int  readBatch(unsigned char* buffer, unsigned int length, unsigned int count, unsigned int* lengths, in_addr* addresses, unsigned int* ports);
 	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
+	// Sends the header and the data as one datagram without joining them first
+	bool write(const unsigned char* header, unsigned int headerLength, const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
+
+	int  getFd() const;
 
 	void close();
 
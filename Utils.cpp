@@ -14,52 +14,70 @@
 #include "Utils.h"
 #include "Log.h"
 
-#include <cstdio>
+#include <cstddef>
 #include <cassert>
 
-void CUtils::dump(const std::string& title, const unsigned char* data, unsigned int length)
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+// "XX " for each of 16 bytes, "   *", 16 characters, '*' and the terminator
+const unsigned int DUMP_ROW_LENGTH = 16U * 3U + 4U + 16U + 2U;
+
+void CUtils::dump(const char* title, const unsigned char* data, unsigned int length)
 {
+	assert(title != NULL);
 	assert(data != NULL);
 
 	dump(2U, title, data, length);
 }
 
-void CUtils::dump(int level, const std::string& title, const unsigned char* data, unsigned int length)
+void CUtils::dump(int level, const char* title, const unsigned char* data, unsigned int length)
 {
+	assert(title != NULL);
 	assert(data != NULL);
 
-	::Log(level, "%s", title.c_str());
+	// Filtered dumps cost nothing more than the level check
+	if (!::LogIsEnabled(level))
+		return;
+
+	::Log(level, "%s", title);
 
 	unsigned int offset = 0U;
 
 	while (length > 0U) {
-		std::string output;
+		char output[DUMP_ROW_LENGTH];
+		char* p = output;
 
 		unsigned int bytes = (length > 16U) ? 16U : length;
 
 		for (unsigned i = 0U; i < bytes; i++) {
-			char temp[10U];
-			::sprintf(temp, "%02X ", data[offset + i]);
-			output += temp;
+			unsigned char c = data[offset + i];
+			*p++ = HEX_DIGITS[c >> 4];
+			*p++ = HEX_DIGITS[c & 0x0FU];
+			*p++ = ' ';
 		}
 
-		for (unsigned int i = bytes; i < 16U; i++)
-			output += "   ";
+		for (unsigned int i = bytes; i < 16U; i++) {
+			*p++ = ' ';
+			*p++ = ' ';
+			*p++ = ' ';
+		}
 
-		output += "   *";
+		*p++ = ' ';
+		*p++ = ' ';
+		*p++ = ' ';
+		*p++ = '*';
 
 		for (unsigned i = 0U; i < bytes; i++) {
 			unsigned char c = data[offset + i];
 
-			if (::isprint(c))
-				output += c;
-			else
-				output += '.';
+			// The printable characters of the C locale
+			*p++ = (c >= 0x20U && c < 0x7FU) ? char(c) : '.';
 		}
 
-		output += '*';
+		*p++ = '*';
+		*p   = '\0';
 
-		::Log(level, "%04X:  %s", offset, output.c_str());
+		::Log(level, "%04X:  %s", offset, output);
 
 		offset += 16U;
 
@@ -70,17 +88,22 @@ void CUtils::dump(int level, const std::string& title, const unsigned char* data
 	}
 }
 
-void CUtils::dump(const std::string& title, const bool* bits, unsigned int length)
+void CUtils::dump(const char* title, const bool* bits, unsigned int length)
 {
+	assert(title != NULL);
 	assert(bits != NULL);
 
 	dump(2U, title, bits, length);
 }
 
-void CUtils::dump(int level, const std::string& title, const bool* bits, unsigned int length)
+void CUtils::dump(int level, const char* title, const bool* bits, unsigned int length)
 {
+	assert(title != NULL);
 	assert(bits != NULL);
 
+	if (!::LogIsEnabled(level))
+		return;
+
 	unsigned char bytes[100U];
 	unsigned int nBytes = 0U;
 	for (unsigned int n = 0U; n < length; n += 8U, nBytes++)